@@ -9,6 +9,10 @@
 #include <ESP32Servo.h>
 #include <uni.h>
 #include "CombatWeapon.h"  // Our weapon library
+#include "PowerBudget.h"   // Battery current arbiter
+#include "ManeuverMacro.h" // Scripted maneuvers
+#include "IdlePower.h"     // Battery saving while waiting
+#include "DriveMix.h"      // Stick-to-ESC mixing
 
 // ============================================================================
 // WEAPON SELECTION - Choose ONE weapon type!
@@ -47,6 +51,25 @@ const unsigned long TURN_BURST_DURATION = 250;  // milliseconds
 const unsigned long UPDATE_INTERVAL = 50;     // milliseconds
 const unsigned long COMMAND_TIMEOUT = 1000;   // milliseconds
 
+// Hot standby - takes over when the primary disconnects or is silent for STANDBY_TAKEOVER_MS
+const bool HOT_STANDBY_ENABLED = false;          // Second paired controller can take over drive
+const unsigned long STANDBY_TAKEOVER_MS = 500;   // Silence before the standby drives (<= COMMAND_TIMEOUT)
+static_assert(STANDBY_TAKEOVER_MS <= COMMAND_TIMEOUT, "standby must take over before the failsafe");
+
+// Reconnect - a primary that drops out keeps its role when it comes back,
+// and scanning stops once every expected controller is in. This does NOT
+// make the reconnect itself faster: the Bluetooth stack and the controller
+// set that time, and no before/after improvement has been measured. The
+// RECONNECT lines on serial log link-back and first-command times - use
+// them to compare if you change anything here.
+
+// Idle power - low CPU clock while disconnected or in the safety delay
+const bool IDLE_POWER_ENABLED = true;
+const uint32_t IDLE_CPU_MHZ = 80;               // 80 is the lowest Bluetooth allows
+const unsigned long IDLE_ENTER_DELAY = 500;     // milliseconds of no input before idling
+const uint32_t IDLE_LOOP_DELAY = 10;            // ticks per loop while idle (bounds wake latency)
+const bool IDLE_LIGHT_SLEEP = false;            // Stops servo PWM on most ESP32 builds - leave off
+
 // ESC settings
 const int ESC_CAL_DELAY = 2000;    // milliseconds
 const int STARTUP_DELAY = 3000;    // milliseconds
@@ -57,6 +80,49 @@ const int NEUTRAL_SPEED = 1500;    // microseconds
 const int MIN_SPEED = 1000;        // microseconds
 const int MAX_SPEED = 2000;        // microseconds
 
+const DriveConfig DRIVE_CONFIG = {
+    MIN_SPEED, MAX_SPEED, INVERT_LEFT_MOTOR, INVERT_RIGHT_MOTOR, INVERT_TURN_DIRECTION
+};
+
+// Power budget - keeps drive + weapon under what the battery can supply
+const float POWER_BUDGET_AMPS = 20.0;                 // amps, whole robot
+const PowerPriority POWER_PRIORITY = POWER_DRIVE_FIRST; // or POWER_WEAPON_FIRST
+const MotorModel DRIVE_MOTOR_MODEL = {0.1, 4.0};      // idle amps, full-throttle amps
+const MotorModel WEAPON_MOTOR_MODEL = {0.2, 15.0};    // idle amps, full-throttle amps
+const unsigned long POWER_STATS_INTERVAL = 5000;      // milliseconds
+const bool LOG_OUTPUT_TRACE = false;                  // Log requested pulses for tools/host_tests
+
+// ============================================================================
+// MANEUVER MACROS
+// ============================================================================
+// Each step holds left stick setpoints (same as pushing the stick) and a
+// weapon speed for a fixed time. Tune pivot time on your own robot.
+// Any stick, trigger or bumper input aborts a running macro.
+
+const int STICK_FORWARD = -512;
+const int STICK_BACK = 512;
+const int STICK_LEFT = -512;
+const int STICK_RIGHT = 512;
+
+// Spin the macro step deadline in the last stretch instead of sleeping
+const unsigned long MACRO_SPIN_WINDOW_US = 1000;   // microseconds
+
+constexpr MacroStep ESCAPE_MACRO[] = {
+    { 150000, 0, STICK_BACK, MACRO_WEAPON_UNCHANGED },     // Back off 150ms
+    { 400000, STICK_RIGHT, 0, MACRO_WEAPON_UNCHANGED },    // Pivot ~180 degrees
+};
+
+constexpr MacroStep CHARGE_MACRO[] = {
+    { 150000, 0, STICK_BACK, 100 },                        // Back off, spinner to max
+    { 400000, STICK_RIGHT, 0, 100 },                       // Pivot ~180 degrees
+    { 600000, 0, STICK_FORWARD, 100 },                     // Charge
+};
+
+constexpr MacroBinding MACRO_BINDINGS[] = {
+    { "Escape", BUTTON_A | BUTTON_B, ESCAPE_MACRO, sizeof(ESCAPE_MACRO) / sizeof(ESCAPE_MACRO[0]) },
+    { "Charge", BUTTON_X | BUTTON_Y, CHARGE_MACRO, sizeof(CHARGE_MACRO) / sizeof(CHARGE_MACRO[0]) },
+};
+
 // ============================================================================
 // WEAPON INSTANTIATION - Automatic based on #define
 // ============================================================================
@@ -86,7 +152,8 @@ enum ControlState {
     STATE_STOPPED,
     STATE_JOYSTICK,
     STATE_TRIGGER,
-    STATE_BUMPER_TURNING
+    STATE_BUMPER_TURNING,
+    STATE_MACRO
 };
 
 // ============================================================================
@@ -96,6 +163,18 @@ enum ControlState {
 // Controller management
 ControllerPtr myControllers[BP32_MAX_GAMEPADS];
 bool controllerConnected = false;
+int primaryIndex = -1;               // Slot of the primary (driving) controller
+bool standbyInControl = false;
+unsigned long lastPrimaryData = 0;
+
+// Primary controller's address - it gets the primary role back after a dropout
+bool primaryKnown = false;
+uint8_t primaryAddr[6];
+
+// Reconnect timing
+unsigned long primaryDisconnectTime = 0;
+unsigned long primaryReconnectTime = 0;
+bool awaitingFirstCommand = false;
 
 // Drive motors
 Servo leftESC;
@@ -104,6 +183,13 @@ int leftSpeed = NEUTRAL_SPEED;
 int rightSpeed = NEUTRAL_SPEED;
 bool escsArmed = false;
 
+// Power budget
+PowerBudget powerBudget;
+int leftPowerChannel = -1;
+int rightPowerChannel = -1;
+int weaponPowerChannel = -1;
+unsigned long lastPowerStats = 0;
+
 // State management
 ControlState currentState = STATE_STOPPED;
 unsigned long turnStartTime = 0;
@@ -111,6 +197,14 @@ bool turnBurstActive = false;
 unsigned long lastCommandTime = 0;
 unsigned long lastUpdate = 0;
 
+// Maneuver macros
+MacroEngine macroEngine;
+int macroWeaponHold = MACRO_WEAPON_UNCHANGED;   // Weapon speed for "unchanged" steps
+
+// Idle power
+IdlePowerManager idlePower;
+unsigned long frameLoopStartUs = 0;   // Start of the loop pass that read the frame
+
 // ============================================================================
 // WEAPON CONFIGURATION
 // ============================================================================
@@ -127,9 +221,19 @@ void configureWeapon() {
         weapon.setSafetyDelay(3000);        // 3 second safety delay
         weapon.setRumbleFeedback(true);     // Enable rumble feedback
         
+        // Stop on e-stop, failsafe or disconnect - coasts by default.
+        // BRAKE_REVERSE_PULSE brakes actively, but only with a bidirectional
+        // ESC, and the brake current must be safe for your ESC and battery.
+        weapon.setBrakeMode(BRAKE_NONE);
+        weapon.setBrakeStrength(300);       // Brake current limit - pulse starts below 60% speed
+        weapon.setMaxBrakeTime(2000);       // Never reverse longer than 2 seconds
+        weapon.setCoastDownTime(8000);      // Model: 8 seconds to coast to a stop
+        weapon.setBrakeStopTime(1500);      // Model: 1.5 seconds to brake to a stop
+        
         Serial.println("  Control: Right stick Y-axis (push up = faster)");
         Serial.println("  Rumble: Enabled (intensity matches speed)");
         Serial.println("  Safety: 3-second delay after connection");
+        Serial.println("  Stop: Coast, spin-down time reported");
         
     #elif defined(USE_LIFTER)
         weapon.setUpButton(1);              // R1 = up
@@ -156,6 +260,26 @@ void configureWeapon() {
     #endif
 }
 
+// ============================================================================
+// POWER BUDGET CONFIGURATION
+// ============================================================================
+
+void configurePowerBudget() {
+    powerBudget.setBudget(POWER_BUDGET_AMPS);
+    powerBudget.setPriority(POWER_PRIORITY);
+    
+    leftPowerChannel = powerBudget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL, NEUTRAL_SPEED);
+    rightPowerChannel = powerBudget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL, NEUTRAL_SPEED);
+    
+    #if defined(USE_VERTICAL_SPINNER) || defined(USE_HORIZONTAL_SPINNER)
+        weaponPowerChannel = powerBudget.addChannel(POWER_GROUP_WEAPON, WEAPON_MOTOR_MODEL, NEUTRAL_SPEED);
+        weapon.setPowerBudget(&powerBudget, weaponPowerChannel);
+    #endif
+    
+    Serial.printf("Power budget: %.1fA, %s first\n", POWER_BUDGET_AMPS,
+        (POWER_PRIORITY == POWER_DRIVE_FIRST) ? "drive" : "weapon");
+}
+
 // ============================================================================
 // ESC INITIALIZATION
 // ============================================================================
@@ -182,6 +306,7 @@ void armESCs() {
     Serial.println("=== Initializing Weapon System ===");
     weapon.begin(WEAPON_PIN);
     configureWeapon();
+    configurePowerBudget();
     Serial.println("=== Weapon System Ready! ===\n");
 }
 
@@ -189,12 +314,8 @@ void armESCs() {
 // HELPER FUNCTIONS
 // ============================================================================
 
-int applyDeadZone(int value, int deadZone) {
-    return (abs(value) < deadZone) ? 0 : value;
-}
-
 int invertSpeed(int speed) {
-    return MIN_SPEED + (MAX_SPEED - speed);
+    return invertSpeed(speed, DRIVE_CONFIG);
 }
 
 void stopMotors() {
@@ -207,30 +328,48 @@ void stopMotors() {
     }
 }
 
+void updateMotors() {
+    if (!escsArmed) return;
+    
+    leftESC.writeMicroseconds(powerBudget.granted(leftPowerChannel));
+    rightESC.writeMicroseconds(powerBudget.granted(rightPowerChannel));
+}
+
+void updatePowerBudget() {
+    // Every output asks the arbiter first, then gets what was granted.
+    // All grants are written in the same pass - a drive pulse left over
+    // from an older resolve() plus a new weapon grant can add up to more
+    // than the budget.
+    powerBudget.request(leftPowerChannel, leftSpeed);
+    powerBudget.request(rightPowerChannel, rightSpeed);
+    powerBudget.resolve();
+    updateMotors();
+    weapon.applyPowerGrant();
+}
+
+void logOutputTrace() {
+    // Requested (not granted) pulses - replayed by the power budget test
+    if (LOG_OUTPUT_TRACE) {
+        Serial.printf("[TRACE] %lu,%d,%d,%d\n", millis(), leftSpeed, rightSpeed,
+            powerBudget.requested(weaponPowerChannel));
+    }
+}
+
 // ============================================================================
 // DRIVE CONTROL HANDLERS
 // ============================================================================
 
+void setDriveFromStick(int axisX, int axisY) {
+    DriveSpeeds speeds = mixDrive(axisX, axisY, DRIVE_CONFIG);
+    leftSpeed = speeds.left;
+    rightSpeed = speeds.right;
+}
+
 void handleJoystickControl(ControllerPtr ctl) {
     int axisX = applyDeadZone(ctl->axisX(), JOYSTICK_DEAD_ZONE);
     int axisY = applyDeadZone(ctl->axisY(), JOYSTICK_DEAD_ZONE);
     
-    if (INVERT_TURN_DIRECTION) {
-        axisX = -axisX;
-    }
-    
-    // Mix for differential drive
-    int leftMotorInput = constrain(axisY + (axisX / 2), -512, 512);
-    int rightMotorInput = constrain(axisY - (axisX / 2), -512, 512);
-    
-    // Map to ESC range
-    leftSpeed = map(leftMotorInput, -512, 512, MIN_SPEED, MAX_SPEED);
-    rightSpeed = map(rightMotorInput, -512, 512, MIN_SPEED, MAX_SPEED);
-    
-    // Apply motor direction inversion
-    if (INVERT_LEFT_MOTOR) leftSpeed = invertSpeed(leftSpeed);
-    if (INVERT_RIGHT_MOTOR) rightSpeed = invertSpeed(rightSpeed);
-    
+    setDriveFromStick(axisX, axisY);
     currentState = STATE_JOYSTICK;
     
     if (VERBOSE_DEBUG) {
@@ -321,17 +460,121 @@ void handleBumperControl(ControllerPtr ctl) {
     if (INVERT_RIGHT_MOTOR) rightSpeed = invertSpeed(rightSpeed);
 }
 
+// ============================================================================
+// MANEUVER MACROS
+// ============================================================================
+
+// Stick, trigger and bumper inputs active in this report
+uint8_t activeInputs(ControllerPtr ctl) {
+    uint8_t inputs = 0;
+    if (abs(ctl->axisX()) > JOYSTICK_DEAD_ZONE || abs(ctl->axisY()) > JOYSTICK_DEAD_ZONE) {
+        inputs |= MACRO_INPUT_LEFT_STICK;
+    }
+    if (abs(ctl->axisRX()) > JOYSTICK_DEAD_ZONE) inputs |= MACRO_INPUT_RIGHT_STICK_X;
+    if (abs(ctl->axisRY()) > JOYSTICK_DEAD_ZONE) inputs |= MACRO_INPUT_RIGHT_STICK_Y;
+    if (ctl->throttle() > TRIGGER_THRESHOLD) inputs |= MACRO_INPUT_THROTTLE;
+    if (ctl->brake() > TRIGGER_THRESHOLD) inputs |= MACRO_INPUT_BRAKE;
+    if (ctl->l1()) inputs |= MACRO_INPUT_L1;
+    if (ctl->r1()) inputs |= MACRO_INPUT_R1;
+    return inputs;
+}
+
+// Inputs the weapon's control mode reads
+uint8_t weaponInputs() {
+    uint8_t inputs = 0;
+    if (weapon.usesInput(WEAPON_INPUT_RIGHT_STICK_Y)) inputs |= MACRO_INPUT_RIGHT_STICK_Y;
+    if (weapon.usesInput(WEAPON_INPUT_THROTTLE)) inputs |= MACRO_INPUT_THROTTLE;
+    if (weapon.usesInput(WEAPON_INPUT_BRAKE)) inputs |= MACRO_INPUT_BRAKE;
+    if (weapon.usesInput(WEAPON_INPUT_L1)) inputs |= MACRO_INPUT_L1;
+    if (weapon.usesInput(WEAPON_INPUT_R1)) inputs |= MACRO_INPUT_R1;
+    return inputs;
+}
+
+void applyMacroStep() {
+    const MacroStep* step = macroEngine.currentStep();
+    
+    if (step) {
+        // "Unchanged" steps hold the weapon where it was when the macro started
+        int weaponPercent = step->weaponPercent;
+        if (weaponPercent == MACRO_WEAPON_UNCHANGED) {
+            weaponPercent = macroWeaponHold;
+        }
+        setDriveFromStick(step->axisX, step->axisY);
+        weapon.setSetpointOverride(weaponPercent);
+        currentState = STATE_MACRO;
+    } else {
+        // Macro finished - stop and hand control back to the driver
+        weapon.setSetpointOverride(MACRO_WEAPON_UNCHANGED);
+        stopMotors();
+    }
+    
+    // Write now instead of waiting for the next loop pass
+    updatePowerBudget();
+}
+
+void abortMacro(const char* reason) {
+    if (!macroEngine.isRunning()) return;
+    
+    macroEngine.abort(reason);
+    weapon.setSetpointOverride(MACRO_WEAPON_UNCHANGED);
+}
+
+void updateMacro() {
+    unsigned long nowUs = micros();
+    
+    // Close to a step boundary - wait it out here rather than in vTaskDelay
+    unsigned long waitUs = macroEngine.timeToNextStep(nowUs);
+    if (waitUs > 0 && waitUs <= MACRO_SPIN_WINDOW_US) {
+        delayMicroseconds(waitUs);
+        nowUs = micros();
+    }
+    
+    if (macroEngine.update(nowUs)) {
+        applyMacroStep();
+    }
+}
+
 // ============================================================================
 // MAIN CONTROL LOGIC
 // ============================================================================
 
-void processGamepad(ControllerPtr ctl) {
+void processGamepad(ControllerPtr ctl, bool weaponControl) {
     if (!escsArmed) return;
     
     lastCommandTime = millis();
     
-    // Update weapon (happens every loop)
-    weapon.update(ctl);
+    uint8_t inputs = activeInputs(ctl);
+    
+    // First real input brings the CPU back to full clock
+    if (inputs || ctl->buttons()) {
+        idlePower.wake(frameLoopStartUs);
+    }
+    
+    // Drive input or the e-stop takes control back from a macro straight
+    // away - the e-stop then runs below like any other frame
+    const char* abortReason = macroAbortReason(inputs, weaponInputs());
+    if (macroEngine.isRunning() && abortReason) {
+        abortMacro(abortReason);
+    }
+    
+    // Button combo starts a macro - never over a held e-stop
+    if (macroEngine.checkBindings(ctl->buttons(), micros())) {
+        if ((inputs & MACRO_INPUT_ESTOP) == MACRO_INPUT_ESTOP) {
+            abortMacro("emergency stop");
+        } else {
+            turnBurstActive = false;
+            macroWeaponHold = weapon.getSetpointPercent();
+            applyMacroStep();
+        }
+    }
+    
+    // Update weapon (happens every loop) - standby controller drives only
+    if (weaponControl) {
+        weapon.update(ctl);
+    }
+    
+    // Macro owns the drive until it finishes or is aborted
+    if (macroEngine.isRunning()) return;
     
     // Get controller inputs
     bool leftBumper = ctl->l1();
@@ -369,90 +612,212 @@ void processGamepad(ControllerPtr ctl) {
     }
 }
 
+ControllerPtr findStandbyController() {
+    for (int i = 0; i < BP32_MAX_GAMEPADS; i++) {
+        ControllerPtr ctl = myControllers[i];
+        if (i != primaryIndex && ctl && ctl->isConnected() && ctl->hasData()) {
+            return ctl;
+        }
+    }
+    return nullptr;
+}
+
 void processControllers() {
-    bool hasActiveController = false;
-    
-    // Find first active controller
-    for (auto myController : myControllers) {
-        if (myController && myController->isConnected() && myController->hasData()) {
-            processGamepad(myController);
-            hasActiveController = true;
-            break;  // Only use one controller at a time
+    ControllerPtr primary = (primaryIndex >= 0) ? myControllers[primaryIndex] : nullptr;
+    bool primaryConnected = primary && primary->isConnected();
+    
+    // Primary controller always drives when it has data
+    if (primaryConnected && primary->hasData()) {
+        lastPrimaryData = millis();
+        
+        if (awaitingFirstCommand) {
+            awaitingFirstCommand = false;
+            Serial.printf("RECONNECT: first command %lu ms after connect (%lu ms since link lost)\n",
+                lastPrimaryData - primaryReconnectTime,
+                lastPrimaryData - primaryDisconnectTime);
+        }
+        
+        if (standbyInControl) {
+            // Primary is back - re-gate the weapon through the safety delay
+            standbyInControl = false;
+            weapon.setConnectionTime(millis());
+            Serial.println("STANDBY: Primary controller back in control");
         }
+        
+        processGamepad(primary, true);
+        return;
     }
     
-    // Safety: stop everything if no active controller
-    if (!hasActiveController) {
-        stopMotors();
-        weapon.emergencyStop();
+    // Primary still connected and only briefly silent - hold outputs.
+    // A short radio hiccup must not cost the weapon.
+    unsigned long silentMs = millis() - lastPrimaryData;
+    if (primaryConnected && silentMs <= STANDBY_TAKEOVER_MS) {
+        return;
+    }
+    
+    // Primary gone, or silent for STANDBY_TAKEOVER_MS - standby
+    // controller takes over drive only
+    if (HOT_STANDBY_ENABLED) {
+        ControllerPtr standby = findStandbyController();
+        if (standby) {
+            if (!standbyInControl) {
+                standbyInControl = true;
+                weapon.emergencyStop();
+                Serial.printf("STANDBY: Taking over drive (primary %s, last data %lu ms ago)\n",
+                    primaryConnected ? "silent" : "disconnected",
+                    silentMs);
+            }
+            processGamepad(standby, false);
+            return;
+        }
     }
+    
+    // No standby - keep holding until the failsafe timeout
+    if (primaryConnected && silentMs <= COMMAND_TIMEOUT) {
+        return;
+    }
+    
+    // Safety: stop everything if no active controller
+    abortMacro("no controller");
+    stopMotors();
+    weapon.emergencyStop();
 }
 
-void updateMotors() {
-    if (!escsArmed) return;
+// ============================================================================
+// IDLE POWER
+// ============================================================================
+
+bool isIdleAllowed() {
+    if (!IDLE_POWER_ENABLED) return false;
     
-    leftESC.writeMicroseconds(leftSpeed);
-    rightESC.writeMicroseconds(rightSpeed);
+    // Only idle in the queue: nobody connected, or still in the safety
+    // delay - and never while anything is moving, including a spinner
+    // still stopping after a disconnect
+    bool waiting = !controllerConnected || weapon.inSafetyDelay();
+    return waiting && currentState == STATE_STOPPED && !macroEngine.isRunning()
+        && !weapon.isStopping();
 }
 
 // ============================================================================
 // BLUEPAD32 CALLBACKS
 // ============================================================================
 
+void updateControllerCount() {
+    int connected = 0;
+    for (int i = 0; i < BP32_MAX_GAMEPADS; i++) {
+        if (myControllers[i] != nullptr) connected++;
+    }
+    controllerConnected = (connected > 0);
+    
+    // Stop scanning once every expected controller is in - scanning shares
+    // the radio with the live link. Scanning resumes as soon as one drops.
+    if (!PAIRING_MODE) {
+        int expected = HOT_STANDBY_ENABLED ? 2 : 1;
+        BP32.enableNewBluetoothConnections(connected < expected);
+    }
+}
+
+bool isKnownPrimary(const ControllerProperties& properties) {
+    return primaryKnown && memcmp(properties.btaddr, primaryAddr, 6) == 0;
+}
+
 void onConnectedController(ControllerPtr ctl) {
-    bool foundEmptySlot = false;
+    ControllerProperties properties = ctl->getProperties();
     
+    // The primary controller coming back after a dropout keeps its role
+    bool reconnecting = isKnownPrimary(properties);
+    
+    int slot = -1;
     for (int i = 0; i < BP32_MAX_GAMEPADS; i++) {
         if (myControllers[i] == nullptr) {
-            ControllerProperties properties = ctl->getProperties();
-            
-            Serial.printf("Controller attempting connection: %02x:%02x:%02x:%02x:%02x:%02x\n",
-                properties.btaddr[0], properties.btaddr[1], properties.btaddr[2],
-                properties.btaddr[3], properties.btaddr[4], properties.btaddr[5]);
-            
-            // Handle pairing mode
-            if (PAIRING_MODE) {
-                bd_addr_t controller_addr;
-                memcpy(controller_addr, properties.btaddr, 6);
-                uni_bt_allowlist_add_addr(controller_addr);
-                uni_bt_allowlist_set_enabled(true);
-                
-                Serial.println("\n*** CONTROLLER SUCCESSFULLY PAIRED! ***");
-                Serial.println("*** Set PAIRING_MODE to false and re-upload ***\n");
-            }
-            
-            myControllers[i] = ctl;
-            controllerConnected = true;
-            foundEmptySlot = true;
-            
-            // Tell weapon about connection time (for safety delay)
-            weapon.setConnectionTime(millis());
-            
-            Serial.printf("Controller connected at index %d\n", i);
+            slot = i;
             break;
         }
     }
     
-    if (!foundEmptySlot) {
+    if (slot < 0) {
         Serial.println("SAFETY: Controller connection rejected - no available slots");
         ctl->disconnect();
+        return;
+    }
+    
+    myControllers[slot] = ctl;
+    
+    if (reconnecting) {
+        primaryIndex = slot;
+        primaryReconnectTime = millis();
+        awaitingFirstCommand = true;
+        Serial.printf("RECONNECT: Primary controller back at index %d after %lu ms\n",
+            slot, primaryReconnectTime - primaryDisconnectTime);
+        
+    } else {
+        Serial.printf("Controller attempting connection: %02x:%02x:%02x:%02x:%02x:%02x\n",
+            properties.btaddr[0], properties.btaddr[1], properties.btaddr[2],
+            properties.btaddr[3], properties.btaddr[4], properties.btaddr[5]);
+        
+        // Handle pairing mode
+        if (PAIRING_MODE) {
+            bd_addr_t controller_addr;
+            memcpy(controller_addr, properties.btaddr, 6);
+            uni_bt_allowlist_add_addr(controller_addr);
+            uni_bt_allowlist_set_enabled(true);
+            
+            Serial.println("\n*** CONTROLLER SUCCESSFULLY PAIRED! ***");
+            Serial.println("*** Set PAIRING_MODE to false and re-upload ***\n");
+        }
+        
+        // First controller in becomes primary. Without hot standby, any
+        // paired controller can replace a primary that has gone away.
+        bool becomesPrimary = !primaryKnown || (primaryIndex < 0 && !HOT_STANDBY_ENABLED);
+        if (becomesPrimary) {
+            primaryIndex = slot;
+            memcpy(primaryAddr, properties.btaddr, 6);
+            primaryKnown = true;
+            Serial.printf("Controller connected at index %d (primary)\n", slot);
+        } else {
+            Serial.printf("Controller connected at index %d (%s)\n", slot,
+                HOT_STANDBY_ENABLED ? "hot standby" : "spare - not used");
+        }
     }
+    
+    // Tell weapon about connection time (for safety delay)
+    if (slot == primaryIndex) {
+        lastPrimaryData = millis();
+        weapon.setConnectionTime(millis());
+    }
+    
+    updateControllerCount();
 }
 
 void onDisconnectedController(ControllerPtr ctl) {
     for (int i = 0; i < BP32_MAX_GAMEPADS; i++) {
         if (myControllers[i] == ctl) {
             myControllers[i] = nullptr;
-            controllerConnected = false;
             
-            // Emergency stop on disconnect
-            stopMotors();
-            weapon.emergencyStop();
-            
-            Serial.printf("Controller disconnected from index %d\n", i);
+            if (i == primaryIndex) {
+                primaryIndex = -1;
+                primaryDisconnectTime = millis();
+                awaitingFirstCommand = false;
+                
+                // Emergency stop on disconnect
+                abortMacro("controller disconnected");
+                stopMotors();
+                weapon.emergencyStop();
+                
+                Serial.printf("Primary controller disconnected from index %d\n", i);
+            } else {
+                if (standbyInControl) {
+                    standbyInControl = false;
+                    abortMacro("controller disconnected");
+                    stopMotors();
+                }
+                Serial.printf("Controller disconnected from index %d\n", i);
+            }
             break;
         }
     }
+    
+    updateControllerCount();
 }
 
 // ============================================================================
@@ -513,6 +878,18 @@ void setup() {
     // Arm ESCs and initialize weapon
     armESCs();
     
+    // Maneuver macros
+    macroEngine.setBindings(MACRO_BINDINGS, sizeof(MACRO_BINDINGS) / sizeof(MACRO_BINDINGS[0]));
+    macroEngine.setVerboseDebug(VERBOSE_DEBUG);
+    Serial.println("Macros: A+B = Escape, X+Y = Charge (any stick input aborts)\n");
+    
+    // Idle power management
+    idlePower.setIdleClockMhz(IDLE_CPU_MHZ);
+    idlePower.setIdleEnterDelay(IDLE_ENTER_DELAY);
+    idlePower.setIdleLoopDelay(IDLE_LOOP_DELAY);
+    idlePower.setLightSleep(IDLE_LIGHT_SLEEP);
+    idlePower.begin();
+    
     Serial.println("=== Setup Complete! ===");
     Serial.println("Waiting for controller connection...\n");
 }
@@ -522,10 +899,12 @@ void setup() {
 // ============================================================================
 
 void loop() {
+    unsigned long loopStartUs = micros();
     unsigned long currentMillis = millis();
     
     // Update Bluepad32 and process controllers
     if (BP32.update()) {
+        frameLoopStartUs = loopStartUs;
         processControllers();
     }
     
@@ -533,17 +912,39 @@ void loop() {
     if (controllerConnected && (currentMillis - lastCommandTime > COMMAND_TIMEOUT)) {
         if (currentState != STATE_STOPPED) {
             Serial.println("SPARC FAILSAFE: Signal lost - stopping all motors");
+            abortMacro("failsafe");
             stopMotors();
             weapon.emergencyStop();
         }
     }
     
-    // Update motors at fixed interval
+    // Step macros on the clock, not on controller reports
+    updateMacro();
+    
+    // Weapon timing that runs with or without a controller (braking)
+    weapon.service();
+    
+    // Share battery current between drive and weapon, and write every output
+    updatePowerBudget();
+    
+    // Log outputs at fixed interval
     if (currentMillis - lastUpdate >= UPDATE_INTERVAL) {
         lastUpdate = currentMillis;
-        updateMotors();
+        logOutputTrace();
     }
     
-    // Small delay for task scheduling
-    vTaskDelay(1);
+    // Report power budget usage for tuning the motor models
+    if (VERBOSE_DEBUG && currentMillis - lastPowerStats >= POWER_STATS_INTERVAL) {
+        lastPowerStats = currentMillis;
+        powerBudget.printStats();
+        idlePower.printStats();
+    }
+    
+    // Drop to idle clock while waiting in the queue. ESC outputs keep
+    // running at neutral - the idle clock never goes below the PWM clock.
+    idlePower.update(isIdleAllowed());
+    idlePower.addBusyTime(micros() - loopStartUs);
+    
+    // Small delay for task scheduling (longer while idle)
+    vTaskDelay(idlePower.loopDelayTicks());
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ CombatWeapon::CombatWeapon()
     , activationTime(0)
     , enableButton(0)
     , verboseDebug(true)
+    , powerBudget(nullptr)
+    , powerChannel(-1)
+    , setpointOverride(-1)
 {
 }
 
@@ -32,6 +35,12 @@ void CombatWeapon::begin(int weaponPin) {
 
 void CombatWeapon::setConnectionTime(unsigned long connectTime) {
     connectionTime = connectTime;
+    
+    // A new connection clears a latched emergency stop. The weapon still
+    // can't move until the safety delay runs out from this moment.
+    if (pin >= 0) {
+        armed = true;
+    }
     debugPrint("Safety delay started");
 }
 
@@ -46,6 +55,12 @@ void CombatWeapon::emergencyStop() {
     debugPrint("EMERGENCY STOP");
 }
 
+bool CombatWeapon::enableButtonUses(WeaponInput input) {
+    // Matches the enable button read in SpinnerWeapon and FlipperWeapon
+    if (enableButton == 1) return input == WEAPON_INPUT_R1;
+    return input == WEAPON_INPUT_BRAKE;   // 0 = R2 analog, 2 = R2 button
+}
+
 bool CombatWeapon::isArmed() {
     return armed && checkSafetyDelay();
 }
@@ -67,10 +82,23 @@ void CombatWeapon::setVerboseDebug(bool enabled) {
     verboseDebug = enabled;
 }
 
+void CombatWeapon::setSetpointOverride(int percent) {
+    setpointOverride = constrain(percent, -1, 100);
+}
+
+void CombatWeapon::setPowerBudget(PowerBudget* budget, int channel) {
+    powerBudget = budget;
+    powerChannel = channel;
+}
+
 bool CombatWeapon::isActive() {
     return active;
 }
 
+bool CombatWeapon::inSafetyDelay() {
+    return !checkSafetyDelay();
+}
+
 unsigned long CombatWeapon::getActiveTime() {
     if (!active) return 0;
     return millis() - activationTime;
@@ -118,12 +146,28 @@ SpinnerWeapon::SpinnerWeapon(WeaponType type)
     , spinUpTime(2000)
     , spinDownTime(3000)
     , lastUpdateTime(0)
+    , rampCarry(0.0)
     , controlMode(2)  // Default to variable speed
     , toggleState(false)
     , lastButtonState(false)
     , rumbleEnabled(true)
     , hasRumbledArmed(false)
     , lastRumbleSpeed(1500)
+    , brakeMode(BRAKE_NONE)
+    , brakeStrength(200)     // Starts braking below 40% speed
+    , maxBrakeTime(2000)     // 2 seconds max braking
+    , rpmSensor(nullptr)
+    , stoppedRpm(100)
+    , fullRpm(0)
+    , braking(false)
+    , stopEventActive(false)
+    , stopStartTime(0)
+    , brakeStartTime(0)
+    , lastSpinDownTime(0)
+    , spinEstimate(0.0)
+    , coastDownTime(8000)    // 8 seconds to coast down from full speed
+    , brakeStopTime(1500)    // 1.5 seconds to brake down from full speed
+    , lastServiceTime(0)
 {
 }
 
@@ -158,7 +202,12 @@ void SpinnerWeapon::update(ControllerPtr controller) {
     // If not armed yet, just idle
     if (!isArmed()) {
         targetSpeed = neutralSpeed;
-        updateSpeed();
+        updateRumble();
+        return;
+    }
+    
+    // Macro running - it sets the speed from service(), driver input is ignored
+    if (setpointOverride >= 0) {
         updateRumble();
         return;
     }
@@ -231,10 +280,29 @@ void SpinnerWeapon::update(ControllerPtr controller) {
         }
     }
     
-    updateSpeed();
+    // Speed ramps in service(), every loop pass
     updateRumble();
 }
 
+void SpinnerWeapon::applySetpointOverride() {
+    if (setpointOverride < 0) return;
+    
+    if (!isArmed()) {
+        targetSpeed = neutralSpeed;
+        return;
+    }
+    
+    targetSpeed = map(setpointOverride, 0, 100, neutralSpeed, maxSpeed);
+    if (setpointOverride > 0 && !active) {
+        active = true;
+        activationTime = millis();
+        debugPrint("SPINNER ON (macro)");
+    } else if (setpointOverride == 0 && active) {
+        active = false;
+        debugPrint("SPINNER OFF (macro)");
+    }
+}
+
 void SpinnerWeapon::updateSpeed() {
     unsigned long currentTime = millis();
     
@@ -247,12 +315,19 @@ void SpinnerWeapon::updateSpeed() {
     unsigned long deltaTime = currentTime - lastUpdateTime;
     lastUpdateTime = currentTime;
     
+    // Fast stop owns the ESC until the spinner has stopped
+    if (braking) return;
+    
     // Calculate ramp rate based on whether spinning up or down
     int rampTime = (targetSpeed > currentSpeed) ? spinUpTime : spinDownTime;
     int speedRange = maxSpeed - neutralSpeed;
     float rampRate = (float)speedRange / (float)rampTime;  // speed units per millisecond
     
-    int maxChange = (int)(rampRate * deltaTime);
+    // Carry the fraction over to the next pass - at a 1ms loop a
+    // 2 second ramp moves 0.25us per pass, which would round to nothing
+    float change = rampRate * deltaTime + rampCarry;
+    int maxChange = (int)change;
+    rampCarry = change - maxChange;
     
     // Ramp towards target speed
     if (currentSpeed < targetSpeed) {
@@ -260,9 +335,150 @@ void SpinnerWeapon::updateSpeed() {
     } else if (currentSpeed > targetSpeed) {
         currentSpeed = max(currentSpeed - maxChange, targetSpeed);
     }
+    if (currentSpeed == targetSpeed) {
+        rampCarry = 0.0;
+    }
+    
+    writeSpeed(currentSpeed);
+}
+
+void SpinnerWeapon::writeSpeed(int speed) {
+    // Send to ESC, or ask the power budget first
+    if (powerBudget) {
+        powerBudget->request(powerChannel, speed);
+    } else {
+        weaponESC.writeMicroseconds(speed);
+    }
+}
+
+void SpinnerWeapon::applyPowerGrant() {
+    if (!powerBudget) return;
+    
+    // Hold the ramp at whatever was granted, so spin-up is delayed
+    // rather than jumping ahead once the drive lets go of the budget
+    int grantedSpeed = powerBudget->granted(powerChannel);
+    if (!braking) {
+        currentSpeed = grantedSpeed;
+    }
+    weaponESC.writeMicroseconds(grantedSpeed);
+}
+
+void SpinnerWeapon::service() {
+    updateSpinEstimate();
+    
+    // Runs between controller reports too, and for a standby pad that
+    // never calls update()
+    applySetpointOverride();
+    updateSpeed();
+    
+    if (!stopEventActive) return;
+    
+    if (braking) {
+        bool stopped = isSpinnerStopped();
+        bool timedOut = (brakeStartTime != 0 && millis() - brakeStartTime >= maxBrakeTime);
+        
+        if (!stopped && !timedOut) {
+            // Deepen the pulse as the blade slows
+            writeBrake();
+        } else {
+            // Drop to neutral once stopped, or when out of brake time
+            braking = false;
+            currentSpeed = neutralSpeed;
+            weaponESC.writeMicroseconds(neutralSpeed);
+            if (powerBudget) {
+                powerBudget->request(powerChannel, neutralSpeed);
+            }
+            
+            if (!stopped) {
+                debugPrint("Brake time limit reached - coasting");
+            }
+        }
+    } else if (targetSpeed > neutralSpeed) {
+        // Re-armed and spinning up again before it ever stopped
+        stopEventActive = false;
+        debugPrint("Spin-down interrupted");
+        return;
+    }
+    
+    if (isSpinnerStopped()) {
+        finishStop();
+    }
+}
+
+void SpinnerWeapon::updateSpinEstimate() {
+    unsigned long currentTime = millis();
+    
+    if (lastServiceTime == 0) {
+        lastServiceTime = currentTime;
+        return;
+    }
+    
+    unsigned long deltaTime = currentTime - lastServiceTime;
+    lastServiceTime = currentTime;
+    
+    // How hard the ESC is driving the blade right now (0.0 - 1.0)
+    float commanded = 0.0;
+    if (maxSpeed > neutralSpeed) {
+        commanded = (float)(currentSpeed - neutralSpeed) / (float)(maxSpeed - neutralSpeed);
+        commanded = constrain(commanded, 0.0f, 1.0f);
+    }
     
-    // Send to ESC
+    if (braking && currentSpeed < neutralSpeed) {
+        spinEstimate -= (float)deltaTime / (float)brakeStopTime;
+    } else if (commanded >= spinEstimate) {
+        spinEstimate = commanded;
+    } else {
+        spinEstimate = max(commanded, spinEstimate - (float)deltaTime / (float)coastDownTime);
+    }
+    spinEstimate = constrain(spinEstimate, 0.0f, 1.0f);
+}
+
+float SpinnerWeapon::spinFraction() {
+    // 0.0 = stopped, 1.0 = full speed - measured if the sensor's full
+    // scale is known, otherwise the model estimate
+    if (rpmSensor && fullRpm > 0) {
+        return constrain((float)rpmSensor() / (float)fullRpm, 0.0f, 1.0f);
+    }
+    return spinEstimate;
+}
+
+int SpinnerWeapon::brakeDepth() {
+    // Brake current comes from the blade's back-EMF as well as the reverse
+    // pulse, so the pulse only gets what the blade speed leaves of the
+    // limit. A fast blade coasts first; the pulse deepens as it slows,
+    // holding the current near the limit instead of spiking at the start.
+    int backEmfUs = (int)(spinFraction() * (maxSpeed - neutralSpeed));
+    return constrain(brakeStrength - backEmfUs, 0, neutralSpeed - 1000);
+}
+
+void SpinnerWeapon::writeBrake() {
+    int depth = brakeDepth();
+    if (depth > 0 && brakeStartTime == 0) {
+        brakeStartTime = max(millis(), 1UL);
+    }
+    
+    currentSpeed = neutralSpeed - depth;
     weaponESC.writeMicroseconds(currentSpeed);
+    if (powerBudget) {
+        powerBudget->request(powerChannel, currentSpeed);
+    }
+}
+
+bool SpinnerWeapon::isSpinnerStopped() {
+    if (rpmSensor) {
+        return rpmSensor() <= stoppedRpm;
+    }
+    return spinEstimate <= 0.01;
+}
+
+void SpinnerWeapon::finishStop() {
+    stopEventActive = false;
+    lastSpinDownTime = millis() - stopStartTime;
+    
+    // Always reported - spin-down time matters for safety, not just debugging
+    Serial.printf("[WEAPON] Spin-down: %lu ms (%s, %s)\n", lastSpinDownTime,
+        (brakeMode == BRAKE_REVERSE_PULSE) ? "active brake" : "coast",
+        rpmSensor ? "RPM sensor" : "model estimate");
 }
 
 void SpinnerWeapon::updateRumble() {
@@ -299,9 +515,30 @@ void SpinnerWeapon::updateRumble() {
 void SpinnerWeapon::emergencyStop() {
     CombatWeapon::emergencyStop();
     targetSpeed = neutralSpeed;
-    currentSpeed = neutralSpeed;
-    weaponESC.writeMicroseconds(neutralSpeed);
     toggleState = false;
+    
+    // Start timing the stop - repeated calls while stopping don't restart it
+    if (!stopEventActive && !isSpinnerStopped()) {
+        stopEventActive = true;
+        stopStartTime = millis();
+        
+        if (brakeMode == BRAKE_REVERSE_PULSE) {
+            braking = true;
+            brakeStartTime = 0;
+            debugPrint("FAST STOP - active braking");
+        }
+    }
+    
+    if (braking) {
+        writeBrake();
+        return;
+    }
+    
+    currentSpeed = neutralSpeed;
+    weaponESC.writeMicroseconds(currentSpeed);
+    if (powerBudget) {
+        powerBudget->request(powerChannel, currentSpeed);
+    }
 }
 
 void SpinnerWeapon::setSpinUpTime(unsigned long milliseconds) {
@@ -328,6 +565,57 @@ void SpinnerWeapon::setRumbleFeedback(bool enabled) {
     rumbleEnabled = enabled;
 }
 
+void SpinnerWeapon::setBrakeMode(BrakeMode mode) {
+    brakeMode = mode;
+}
+
+void SpinnerWeapon::setBrakeStrength(int microseconds) {
+    brakeStrength = constrain(microseconds, 0, 1000);
+}
+
+void SpinnerWeapon::setMaxBrakeTime(unsigned long milliseconds) {
+    maxBrakeTime = constrain(milliseconds, 100, 10000);
+}
+
+void SpinnerWeapon::setRpmSensor(long (*readRpm)(), long rpmThreshold, long rpmAtFullSpeed) {
+    rpmSensor = readRpm;
+    stoppedRpm = rpmThreshold;
+    fullRpm = max(rpmAtFullSpeed, 0L);
+}
+
+void SpinnerWeapon::setCoastDownTime(unsigned long milliseconds) {
+    coastDownTime = max(milliseconds, 1UL);
+}
+
+void SpinnerWeapon::setBrakeStopTime(unsigned long milliseconds) {
+    brakeStopTime = max(milliseconds, 1UL);
+}
+
+int SpinnerWeapon::getSetpointPercent() {
+    // Where the blade is now, not where the stick is - the driver's thumb
+    // has usually left the stick to press a macro combo
+    int speedRange = maxSpeed - neutralSpeed;
+    if (speedRange <= 0 || braking) return 0;
+    return constrain(((currentSpeed - neutralSpeed) * 100) / speedRange, 0, 100);
+}
+
+bool SpinnerWeapon::usesInput(WeaponInput input) {
+    if (controlMode == 2) return input == WEAPON_INPUT_RIGHT_STICK_Y;
+    return enableButtonUses(input);
+}
+
+bool SpinnerWeapon::isBraking() {
+    return braking;
+}
+
+bool SpinnerWeapon::isStopping() {
+    return stopEventActive;
+}
+
+unsigned long SpinnerWeapon::getLastSpinDownTime() {
+    return lastSpinDownTime;
+}
+
 // ============================================================================
 // LIFTER WEAPON CLASS - Implementation
 // ============================================================================
@@ -343,6 +631,7 @@ LifterWeapon::LifterWeapon()
     , upButton(1)    // R1
     , downButton(0)  // R2
     , lastUpdateTime(0)
+    , moveCarry(0.0)
 {
 }
 
@@ -408,14 +697,21 @@ void LifterWeapon::updatePosition() {
     unsigned long deltaTime = currentTime - lastUpdateTime;
     lastUpdateTime = currentTime;
     
-    // Calculate maximum angle change based on speed setting
-    float maxChange = ((float)speed * (float)deltaTime) / 1000.0;
+    // Calculate maximum angle change based on speed setting. Carry the
+    // fraction over - at 90 deg/s and 10ms reports a step is 0.9 degrees,
+    // which would round to nothing and the lifter would never move.
+    float change = ((float)speed * (float)deltaTime) / 1000.0 + moveCarry;
+    int maxChange = (int)change;
+    moveCarry = change - maxChange;
     
     // Move towards target angle
     if (currentAngle < targetAngle) {
-        currentAngle = min(currentAngle + (int)maxChange, targetAngle);
+        currentAngle = min(currentAngle + maxChange, targetAngle);
     } else if (currentAngle > targetAngle) {
-        currentAngle = max(currentAngle - (int)maxChange, targetAngle);
+        currentAngle = max(currentAngle - maxChange, targetAngle);
+    }
+    if (currentAngle == targetAngle) {
+        moveCarry = 0.0;
     }
     
     lifterServo.write(currentAngle);
@@ -426,6 +722,14 @@ void LifterWeapon::emergencyStop() {
     targetAngle = minAngle;
 }
 
+bool LifterWeapon::usesInput(WeaponInput input) {
+    if (controlMode == 1) return input == WEAPON_INPUT_RIGHT_STICK_Y;
+    
+    WeaponInput up = (upButton == 1) ? WEAPON_INPUT_R1 : WEAPON_INPUT_BRAKE;
+    WeaponInput down = (downButton == 0) ? WEAPON_INPUT_THROTTLE : WEAPON_INPUT_L1;
+    return input == up || input == down;
+}
+
 void LifterWeapon::setRange(int minA, int maxA) {
     minAngle = constrain(minA, 0, 180);
     maxAngle = constrain(maxA, 0, 180);
@@ -535,6 +839,10 @@ void FlipperWeapon::emergencyStop() {
     firing = false;
 }
 
+bool FlipperWeapon::usesInput(WeaponInput input) {
+    return enableButtonUses(input);
+}
+
 void FlipperWeapon::setFireDuration(unsigned long milliseconds) {
     fireDuration = constrain(milliseconds, 50, 1000);
 }
@@ -13,6 +13,7 @@
 #include <Arduino.h>
 #include <ESP32Servo.h>
 #include <Bluepad32.h>
+#include "PowerBudget.h"
 
 // ============================================================================
 // WEAPON TYPES
@@ -26,6 +27,21 @@ enum WeaponType {
     WEAPON_FLIPPER
 };
 
+// How a spinner is stopped on emergency stop, failsafe or disconnect
+enum BrakeMode {
+    BRAKE_NONE,           // Cut to neutral and let the blade coast
+    BRAKE_REVERSE_PULSE   // Speed-limited reverse pulse (bidirectional ESC)
+};
+
+// Controller inputs a weapon can be set up to read
+enum WeaponInput {
+    WEAPON_INPUT_RIGHT_STICK_Y,   // axisRY()
+    WEAPON_INPUT_THROTTLE,        // throttle()
+    WEAPON_INPUT_BRAKE,           // brake() / r2()
+    WEAPON_INPUT_L1,              // l1()
+    WEAPON_INPUT_R1               // r1()
+};
+
 // ============================================================================
 // BASE WEAPON CLASS
 // ============================================================================
@@ -53,6 +69,7 @@ public:
     
     // Status checking
     bool isActive();
+    bool inSafetyDelay();
     unsigned long getActiveTime();
     
     // Configuration
@@ -60,6 +77,24 @@ public:
     void setEnableButton(int button);
     void setVerboseDebug(bool enabled);
     
+    // Power budget - weapon output goes through the arbiter when set
+    void setPowerBudget(PowerBudget* budget, int channel);
+    virtual void applyPowerGrant() {}
+    
+    // Called every loop pass, controller or not (macro setpoints, ramps,
+    // timed stops, braking)
+    virtual void service() {}
+    
+    // Macro control - 0-100 overrides the driver, -1 hands control back
+    void setSetpointOverride(int percent);
+    virtual int getSetpointPercent() { return -1; }   // -1 = nothing to hold
+    
+    // True if the current control mode reads this input
+    virtual bool usesInput(WeaponInput) { return false; }
+    
+    // True while a stop is still winding down (blade spinning after a stop)
+    virtual bool isStopping() { return false; }
+    
 protected:
     // Protected members - accessible by derived classes
     int pin;
@@ -70,9 +105,13 @@ protected:
     unsigned long activationTime;
     int enableButton;
     bool verboseDebug;
+    PowerBudget* powerBudget;
+    int powerChannel;
+    int setpointOverride;
     
     // Helper methods
     bool checkSafetyDelay();
+    bool enableButtonUses(WeaponInput input);
     void debugPrint(const char* message);
 };
 
@@ -108,6 +147,10 @@ public:
     void begin(int weaponPin) override;
     void update(ControllerPtr controller) override;
     void emergencyStop() override;
+    void applyPowerGrant() override;
+    void service() override;
+    int getSetpointPercent() override;
+    bool usesInput(WeaponInput input) override;
     
     // Spinner-specific configuration
     void setSpinUpTime(unsigned long milliseconds);
@@ -117,6 +160,19 @@ public:
     void setControlMode(int mode);        // 0=toggle, 1=hold, 2=variable
     void setRumbleFeedback(bool enabled);
     
+    // Fast stop configuration
+    void setBrakeMode(BrakeMode mode);
+    void setBrakeStrength(int microseconds);       // Brake current limit: speed + reverse depth (500us = full speed)
+    void setMaxBrakeTime(unsigned long milliseconds);   // Longest reverse pulse, after any coasting
+    void setRpmSensor(long (*readRpm)(), long stoppedRpm, long fullRpm = 0);
+    void setCoastDownTime(unsigned long milliseconds);  // Model: full speed to stop, coasting
+    void setBrakeStopTime(unsigned long milliseconds);  // Model: full speed to stop, braking
+    
+    // Status checking
+    bool isBraking();
+    bool isStopping() override;
+    unsigned long getLastSpinDownTime();
+    
 private:
     // Hardware interface
     Servo weaponESC;
@@ -134,6 +190,7 @@ private:
     unsigned long spinUpTime;
     unsigned long spinDownTime;
     unsigned long lastUpdateTime;
+    float rampCarry;             // Ramp step left over from the last pass
     
     // Control state
     int controlMode;
@@ -145,9 +202,36 @@ private:
     bool hasRumbledArmed;
     int lastRumbleSpeed;
     
+    // Fast stop
+    BrakeMode brakeMode;
+    int brakeStrength;
+    unsigned long maxBrakeTime;
+    long (*rpmSensor)();
+    long stoppedRpm;
+    long fullRpm;                // 0 = use the speed model for brake depth
+    bool braking;
+    bool stopEventActive;
+    unsigned long stopStartTime;
+    unsigned long brakeStartTime;   // First reverse pulse, 0 while coasting
+    unsigned long lastSpinDownTime;
+    
+    // Speed model - used when there is no RPM sensor
+    float spinEstimate;          // 0.0 = stopped, 1.0 = full speed
+    unsigned long coastDownTime;
+    unsigned long brakeStopTime;
+    unsigned long lastServiceTime;
+    
     // Helper methods
     void updateSpeed();
     void updateRumble();
+    void applySetpointOverride();
+    void writeSpeed(int speed);
+    void updateSpinEstimate();
+    float spinFraction();
+    int brakeDepth();
+    void writeBrake();
+    bool isSpinnerStopped();
+    void finishStop();
 };
 
 // ============================================================================
@@ -166,6 +250,7 @@ public:
     void begin(int weaponPin) override;
     void update(ControllerPtr controller) override;
     void emergencyStop() override;
+    bool usesInput(WeaponInput input) override;
     
     // Lifter-specific configuration
     void setRange(int minAngle, int maxAngle);
@@ -190,6 +275,7 @@ private:
     int upButton;
     int downButton;
     unsigned long lastUpdateTime;
+    float moveCarry;             // Move step left over from the last update
     
     // Helper methods
     void updatePosition();
@@ -211,6 +297,7 @@ public:
     void begin(int weaponPin) override;
     void update(ControllerPtr controller) override;
     void emergencyStop() override;
+    bool usesInput(WeaponInput input) override;
     
     // Flipper-specific configuration
     void setFireDuration(unsigned long milliseconds);
@@ -0,0 +1,36 @@
+// ============================================================================
+// DriveMix.cpp - Implementation of tank drive mixing
+//
+// See DriveMix.h for DECLARATIONS (what functions exist).
+// ============================================================================
+
+#include "DriveMix.h"
+
+int applyDeadZone(int value, int deadZone) {
+    return (abs(value) < deadZone) ? 0 : value;
+}
+
+int invertSpeed(int speed, const DriveConfig& config) {
+    return config.minSpeed + (config.maxSpeed - speed);
+}
+
+DriveSpeeds mixDrive(int axisX, int axisY, const DriveConfig& config) {
+    if (config.invertTurn) {
+        axisX = -axisX;
+    }
+    
+    // Mix for differential drive
+    int leftMotorInput = constrain(axisY + (axisX / 2), -512, 512);
+    int rightMotorInput = constrain(axisY - (axisX / 2), -512, 512);
+    
+    // Map to ESC range
+    DriveSpeeds speeds;
+    speeds.left = map(leftMotorInput, -512, 512, config.minSpeed, config.maxSpeed);
+    speeds.right = map(rightMotorInput, -512, 512, config.minSpeed, config.maxSpeed);
+    
+    // Apply motor direction inversion
+    if (config.invertLeft) speeds.left = invertSpeed(speeds.left, config);
+    if (config.invertRight) speeds.right = invertSpeed(speeds.right, config);
+    
+    return speeds;
+}
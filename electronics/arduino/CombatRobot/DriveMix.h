@@ -0,0 +1,42 @@
+// ============================================================================
+// DriveMix.h - Stick-to-ESC mixing for two-wheel (tank) drive
+//
+// Plain functions with no hardware access, so the same mixing runs on the
+// robot and in host-side tools.
+//
+// Usage: #include "DriveMix.h" in your main sketch
+// ============================================================================
+
+#ifndef DRIVE_MIX_H
+#define DRIVE_MIX_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// DRIVE CONFIGURATION
+// ============================================================================
+
+struct DriveConfig {
+    int minSpeed;       // ESC full reverse (microseconds)
+    int maxSpeed;       // ESC full forward (microseconds)
+    bool invertLeft;    // Left motor wired backwards
+    bool invertRight;   // Right motor wired backwards
+    bool invertTurn;    // Swap left/right turning
+};
+
+struct DriveSpeeds {
+    int left;           // Left ESC pulse (microseconds)
+    int right;          // Right ESC pulse (microseconds)
+};
+
+// ============================================================================
+// MIXING FUNCTIONS
+// ============================================================================
+
+int applyDeadZone(int value, int deadZone);
+int invertSpeed(int speed, const DriveConfig& config);
+
+// Left stick (-512 to 512 per axis) to left/right ESC pulses
+DriveSpeeds mixDrive(int axisX, int axisY, const DriveConfig& config);
+
+#endif // DRIVE_MIX_H
@@ -0,0 +1,167 @@
+// ============================================================================
+// IdlePower.cpp - Implementation of idle power management
+//
+// See IdlePower.h for DECLARATIONS (what methods exist).
+// ============================================================================
+
+#include "IdlePower.h"
+
+// Automatic light sleep needs power management and tickless idle turned on
+// in the ESP-IDF build. Most Arduino cores ship without them, so this is
+// compiled in only where it can work.
+#if defined(CONFIG_PM_ENABLE) && defined(CONFIG_FREERTOS_USE_TICKLESS_IDLE) && ESP_IDF_VERSION_MAJOR >= 5
+    #include <esp_pm.h>
+    #define IDLE_LIGHT_SLEEP_AVAILABLE 1
+#else
+    #define IDLE_LIGHT_SLEEP_AVAILABLE 0
+#endif
+
+IdlePowerManager::IdlePowerManager()
+    : idle(false)
+    , lightSleepEnabled(false)
+    , fullClockMhz(240)
+    , idleClockMhz(80)        // Lowest clock that keeps Bluetooth and LEDC PWM running
+    , idleLoopDelay(10)       // 10 ticks - input frames still picked up within 10ms
+    , idleEnterDelay(500)     // 0.5 seconds of nothing happening before idling
+    , lastBusyTime(0)
+    , windowStartUs(0)
+    , windowBusyUs(0)
+{
+    stats.idleEntries = 0;
+    stats.wakes = 0;
+    stats.lastWakeUs = 0;
+    stats.maxWakeUs = 0;
+    stats.pollBoundUs = idleLoopDelay * portTICK_PERIOD_MS * 1000UL;
+    stats.busyPercent = 0.0;
+}
+
+void IdlePowerManager::begin() {
+    fullClockMhz = getCpuFrequencyMhz();
+    lastBusyTime = millis();
+    windowStartUs = micros();
+
+    if (lightSleepEnabled && !IDLE_LIGHT_SLEEP_AVAILABLE) {
+        Serial.println("[IDLE] Light sleep not available in this build - clock scaling only");
+        lightSleepEnabled = false;
+    }
+
+    Serial.printf("[IDLE] Full clock %luMHz, idle clock %luMHz%s\n",
+        (unsigned long)fullClockMhz, (unsigned long)idleClockMhz,
+        lightSleepEnabled ? " + light sleep" : "");
+}
+
+void IdlePowerManager::setIdleClockMhz(uint32_t mhz) {
+    idleClockMhz = max(mhz, (uint32_t)80);
+}
+
+void IdlePowerManager::setIdleEnterDelay(unsigned long ms) {
+    idleEnterDelay = ms;
+}
+
+void IdlePowerManager::setIdleLoopDelay(uint32_t ticks) {
+    idleLoopDelay = max(ticks, (uint32_t)1);
+    stats.pollBoundUs = idleLoopDelay * portTICK_PERIOD_MS * 1000UL;
+}
+
+void IdlePowerManager::setLightSleep(bool enabled) {
+    lightSleepEnabled = enabled;
+}
+
+void IdlePowerManager::update(bool idleAllowed) {
+    if (!idleAllowed) {
+        lastBusyTime = millis();
+        if (idle) {
+            // Not an input frame (e.g. safety delay over) - not a wake
+            exitIdle();
+            Serial.println("[IDLE] Active");
+        }
+        return;
+    }
+
+    if (!idle && millis() - lastBusyTime >= idleEnterDelay) {
+        enterIdle();
+    }
+}
+
+void IdlePowerManager::enterIdle() {
+    idle = true;
+    stats.idleEntries++;
+
+    if (lightSleepEnabled) {
+        configureLightSleep(true);
+    } else {
+        setCpuFrequencyMhz(idleClockMhz);
+    }
+
+    Serial.printf("[IDLE] Idle - CPU at %luMHz\n", (unsigned long)idleClockMhz);
+}
+
+void IdlePowerManager::wake(unsigned long loopStartUs) {
+    lastBusyTime = millis();
+    if (!idle) return;
+
+    exitIdle();
+
+    // Measured from the start of the loop pass that picked up the frame.
+    // The frame may also have waited up to one idle loop delay before
+    // that pass began - micros() can't see it, so it is reported as a bound.
+    stats.wakes++;
+    stats.lastWakeUs = micros() - loopStartUs;
+    stats.maxWakeUs = max(stats.maxWakeUs, stats.lastWakeUs);
+
+    Serial.printf("[IDLE] Awake - full clock in %luus (+ up to %luus waiting for the poll)\n",
+        stats.lastWakeUs, stats.pollBoundUs);
+}
+
+void IdlePowerManager::exitIdle() {
+    if (lightSleepEnabled) {
+        configureLightSleep(false);
+    } else {
+        setCpuFrequencyMhz(fullClockMhz);
+    }
+    idle = false;
+}
+
+void IdlePowerManager::configureLightSleep(bool enabled) {
+#if IDLE_LIGHT_SLEEP_AVAILABLE
+    esp_pm_config_t pmConfig;
+    pmConfig.max_freq_mhz = enabled ? idleClockMhz : fullClockMhz;
+    pmConfig.min_freq_mhz = enabled ? idleClockMhz : fullClockMhz;
+    pmConfig.light_sleep_enable = enabled;
+    esp_pm_configure(&pmConfig);
+#else
+    (void)enabled;
+#endif
+}
+
+void IdlePowerManager::addBusyTime(unsigned long busyUs) {
+    windowBusyUs += busyUs;
+}
+
+bool IdlePowerManager::isIdle() {
+    return idle;
+}
+
+uint32_t IdlePowerManager::loopDelayTicks() {
+    return idle ? idleLoopDelay : 1;
+}
+
+const IdlePowerStats& IdlePowerManager::getStats() {
+    return stats;
+}
+
+void IdlePowerManager::printStats() {
+    // Busy percentage over the time since the last report
+    unsigned long nowUs = micros();
+    unsigned long windowUs = nowUs - windowStartUs;
+    if (windowUs > 0) {
+        stats.busyPercent = (100.0 * windowBusyUs) / windowUs;
+    }
+    windowStartUs = nowUs;
+    windowBusyUs = 0;
+
+    Serial.printf("[IDLE] %s @%luMHz | busy %.1f%% | idle %lu times, woke %lu times | wake %luus last, %luus max (+ up to %luus poll)\n",
+        idle ? "IDLE" : "ACTIVE", (unsigned long)getCpuFrequencyMhz(),
+        stats.busyPercent, stats.idleEntries, stats.wakes,
+        stats.lastWakeUs, stats.maxWakeUs, stats.pollBoundUs);
+}
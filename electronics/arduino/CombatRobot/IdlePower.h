@@ -0,0 +1,82 @@
+// ============================================================================
+// IdlePower.h - Battery saving while the robot waits in the queue
+//
+// Drops the CPU clock (and optionally uses automatic light sleep) while no
+// controller is connected or the weapon safety delay is still running.
+// Full clock comes back on the first input frame.
+//
+// Usage: #include "IdlePower.h" in your main sketch
+// ============================================================================
+
+#ifndef IDLE_POWER_H
+#define IDLE_POWER_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// IDLE POWER STATISTICS
+// ============================================================================
+
+struct IdlePowerStats {
+    unsigned long idleEntries;     // Times idle mode was entered
+    unsigned long wakes;           // Times an input frame woke the robot
+    unsigned long lastWakeUs;      // Loop entry -> full clock, last input wake
+    unsigned long maxWakeUs;       // Loop entry -> full clock, worst input wake
+    unsigned long pollBoundUs;     // Extra time a frame can wait for the idle loop
+    float busyPercent;             // Loop time not spent in vTaskDelay
+};
+
+// ============================================================================
+// IDLE POWER MANAGER CLASS
+// ============================================================================
+
+class IdlePowerManager {
+public:
+    // Constructor
+    IdlePowerManager();
+
+    // Setup and initialization
+    void begin();
+
+    // Configuration
+    void setIdleClockMhz(uint32_t mhz);       // 80 is the lowest Bluetooth allows
+    void setIdleEnterDelay(unsigned long ms);
+    void setIdleLoopDelay(uint32_t ticks);
+    void setLightSleep(bool enabled);
+
+    // Main control - call update() every loop, wake() on an input frame
+    // with the micros() taken at the start of that loop pass
+    void update(bool idleAllowed);
+    void wake(unsigned long loopStartUs);
+
+    // CPU-busy measurement - time spent working in each loop pass
+    void addBusyTime(unsigned long busyUs);
+
+    // Status checking
+    bool isIdle();
+    uint32_t loopDelayTicks();
+    const IdlePowerStats& getStats();
+    void printStats();
+
+private:
+    bool idle;
+    bool lightSleepEnabled;
+    uint32_t fullClockMhz;
+    uint32_t idleClockMhz;
+    uint32_t idleLoopDelay;
+    unsigned long idleEnterDelay;
+    unsigned long lastBusyTime;
+
+    // Busy measurement window
+    unsigned long windowStartUs;
+    unsigned long windowBusyUs;
+
+    IdlePowerStats stats;
+
+    // Helper methods
+    void enterIdle();
+    void exitIdle();
+    void configureLightSleep(bool enabled);
+};
+
+#endif // IDLE_POWER_H
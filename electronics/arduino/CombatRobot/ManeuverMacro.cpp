@@ -0,0 +1,128 @@
+// ============================================================================
+// ManeuverMacro.cpp - Implementation of the macro engine
+//
+// See ManeuverMacro.h for DECLARATIONS (what methods exist).
+// ============================================================================
+
+#include "ManeuverMacro.h"
+
+MacroEngine::MacroEngine()
+    : bindings(nullptr)
+    , bindingCount(0)
+    , lastButtons(0)
+    , active(nullptr)
+    , stepIndex(0)
+    , stepDeadlineUs(0)
+    , maxLatenessUs(0)
+    , verboseDebug(true)
+{
+}
+
+void MacroEngine::setBindings(const MacroBinding* table, int count) {
+    bindings = table;
+    bindingCount = count;
+}
+
+void MacroEngine::setVerboseDebug(bool enabled) {
+    verboseDebug = enabled;
+}
+
+bool MacroEngine::checkBindings(uint16_t buttons, unsigned long nowUs) {
+    uint16_t previous = lastButtons;
+    lastButtons = buttons;
+
+    if (active) return false;
+
+    for (int i = 0; i < bindingCount; i++) {
+        uint16_t combo = bindings[i].buttons;
+        bool heldNow = (buttons & combo) == combo;
+        bool heldBefore = (previous & combo) == combo;
+
+        // Start only on the press, not while the combo is held
+        if (heldNow && !heldBefore) {
+            start(&bindings[i], nowUs);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MacroEngine::start(const MacroBinding* binding, unsigned long nowUs) {
+    if (!binding || binding->stepCount == 0) return;
+
+    active = binding;
+    stepIndex = 0;
+    stepDeadlineUs = nowUs + active->steps[0].durationUs;
+
+    if (verboseDebug) {
+        Serial.printf("[MACRO] %s started (%d steps)\n", active->name, active->stepCount);
+    }
+}
+
+bool MacroEngine::update(unsigned long nowUs) {
+    if (!active) return false;
+
+    // Deadline not reached yet (wrap-safe compare)
+    if ((long)(nowUs - stepDeadlineUs) < 0) return false;
+
+    unsigned long lateness = nowUs - stepDeadlineUs;
+    maxLatenessUs = max(maxLatenessUs, lateness);
+
+    stepIndex++;
+    if (stepIndex >= active->stepCount) {
+        if (verboseDebug) {
+            Serial.printf("[MACRO] %s complete (+%luus)\n", active->name, lateness);
+        }
+        active = nullptr;
+        return true;
+    }
+
+    // Next deadline counts from the previous deadline, not from now,
+    // so a late loop doesn't push every following step back
+    stepDeadlineUs += active->steps[stepIndex].durationUs;
+
+    if (verboseDebug) {
+        Serial.printf("[MACRO] %s step %d/%d (+%luus)\n",
+            active->name, stepIndex + 1, active->stepCount, lateness);
+    }
+    return true;
+}
+
+void MacroEngine::abort(const char* reason) {
+    if (!active) return;
+
+    if (verboseDebug) {
+        Serial.printf("[MACRO] %s aborted: %s\n", active->name, reason);
+    }
+    active = nullptr;
+}
+
+bool MacroEngine::isRunning() {
+    return active != nullptr;
+}
+
+const MacroStep* MacroEngine::currentStep() {
+    if (!active) return nullptr;
+    return &active->steps[stepIndex];
+}
+
+unsigned long MacroEngine::timeToNextStep(unsigned long nowUs) {
+    if (!active) return 0xFFFFFFFF;
+    if ((long)(nowUs - stepDeadlineUs) >= 0) return 0;
+    return stepDeadlineUs - nowUs;
+}
+
+unsigned long MacroEngine::getMaxLatenessUs() {
+    return maxLatenessUs;
+}
+
+const char* macroAbortReason(uint8_t activeInputs, uint8_t weaponInputs) {
+    // Checked before the weapon filter - the e-stop can't be masked away
+    if ((activeInputs & MACRO_INPUT_ESTOP) == MACRO_INPUT_ESTOP) {
+        return "emergency stop";
+    }
+    if (activeInputs & ~weaponInputs) {
+        return "driver input";
+    }
+    return nullptr;
+}
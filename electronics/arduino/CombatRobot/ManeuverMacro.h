@@ -0,0 +1,112 @@
+// ============================================================================
+// ManeuverMacro.h - Scripted drive and weapon sequences
+//
+// A macro is a short table of steps ("back up 150ms, pivot, charge").
+// Each step holds stick setpoints for a fixed number of microseconds.
+// The main loop steps the macro on the clock, not on controller reports,
+// and any driver input aborts it immediately.
+//
+// Usage: #include "ManeuverMacro.h" in your main sketch
+// ============================================================================
+
+#ifndef MANEUVER_MACRO_H
+#define MANEUVER_MACRO_H
+
+#include <Arduino.h>
+
+// Weapon setpoint that keeps the weapon at the speed it had when the macro
+// started (the sketch holds it - the combo takes the thumb off the stick)
+const int8_t MACRO_WEAPON_UNCHANGED = -1;
+
+// ============================================================================
+// MACRO TABLES
+// ============================================================================
+// Declare macros as constexpr arrays so they live in flash:
+//
+//   constexpr MacroStep BACK_OFF[] = {
+//       { 150000, 0, STICK_BACK, MACRO_WEAPON_UNCHANGED },
+//   };
+// ============================================================================
+
+struct MacroStep {
+    uint32_t durationUs;    // How long to hold this step (microseconds)
+    int16_t axisX;          // Left stick X setpoint (-512 to 512)
+    int16_t axisY;          // Left stick Y setpoint (-512 to 512)
+    int8_t weaponPercent;   // 0-100, or MACRO_WEAPON_UNCHANGED
+};
+
+struct MacroBinding {
+    const char* name;
+    uint16_t buttons;       // Button combo that starts it (BUTTON_A | BUTTON_B)
+    const MacroStep* steps;
+    uint8_t stepCount;
+};
+
+// ============================================================================
+// MACRO ENGINE CLASS
+// ============================================================================
+
+class MacroEngine {
+public:
+    // Constructor
+    MacroEngine();
+
+    // Configuration
+    void setBindings(const MacroBinding* table, int count);
+    void setVerboseDebug(bool enabled);
+
+    // Call with the controller's buttons() on every report.
+    // Returns true if a combo was just pressed and its macro started.
+    bool checkBindings(uint16_t buttons, unsigned long nowUs);
+
+    // Main control - update() returns true when the setpoints changed
+    void start(const MacroBinding* binding, unsigned long nowUs);
+    bool update(unsigned long nowUs);
+    void abort(const char* reason);
+
+    // Status checking
+    bool isRunning();
+    const MacroStep* currentStep();   // nullptr when no macro is running
+    unsigned long timeToNextStep(unsigned long nowUs);
+    unsigned long getMaxLatenessUs();
+
+private:
+    const MacroBinding* bindings;
+    int bindingCount;
+    uint16_t lastButtons;
+
+    // Running macro
+    const MacroBinding* active;
+    int stepIndex;
+    unsigned long stepDeadlineUs;
+    unsigned long maxLatenessUs;
+    bool verboseDebug;
+};
+
+// ============================================================================
+// MACRO ABORT
+// ============================================================================
+// Which controller inputs are active this report, as a bitmask. The sketch
+// fills one mask from the controller and one with the inputs the weapon
+// reads, and macroAbortReason() decides whether the driver takes over.
+// ============================================================================
+
+enum MacroInput : uint8_t {
+    MACRO_INPUT_LEFT_STICK    = 0x01,   // Past the dead zone
+    MACRO_INPUT_RIGHT_STICK_X = 0x02,
+    MACRO_INPUT_RIGHT_STICK_Y = 0x04,
+    MACRO_INPUT_THROTTLE      = 0x08,   // throttle() past the threshold
+    MACRO_INPUT_BRAKE         = 0x10,   // brake() past the threshold
+    MACRO_INPUT_L1            = 0x20,
+    MACRO_INPUT_R1            = 0x40
+};
+
+// Both triggers - the emergency stop
+const uint8_t MACRO_INPUT_ESTOP = MACRO_INPUT_THROTTLE | MACRO_INPUT_BRAKE;
+
+// Returns why a running macro must stop, or nullptr to keep it running.
+// The emergency stop always aborts, even when the weapon reads both
+// triggers. Other weapon inputs don't, so the driver can keep the weapon on.
+const char* macroAbortReason(uint8_t activeInputs, uint8_t weaponInputs);
+
+#endif // MANEUVER_MACRO_H
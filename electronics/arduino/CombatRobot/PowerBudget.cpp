@@ -0,0 +1,136 @@
+// ============================================================================
+// PowerBudget.cpp - Implementation of the battery current arbiter
+//
+// See PowerBudget.h for DECLARATIONS (what methods exist).
+// ============================================================================
+
+#include "PowerBudget.h"
+
+// Pulse width change from neutral to full throttle (1500us -> 2000us)
+static const int FULL_DEFLECTION_US = 500;
+
+PowerBudget::PowerBudget()
+    : channelCount(0)
+    , priority(POWER_DRIVE_FIRST)
+{
+    stats.budgetAmps = 20.0;  // 20A default - typical 2S antweight pack
+    resetStats();
+}
+
+int PowerBudget::addChannel(PowerGroup group, MotorModel model, int neutralUs) {
+    if (channelCount >= MAX_CHANNELS) return -1;
+
+    Channel& ch = channels[channelCount];
+    ch.group = group;
+    ch.model = model;
+    ch.neutralUs = neutralUs;
+    ch.requestedUs = neutralUs;
+    ch.grantedUs = neutralUs;
+
+    return channelCount++;
+}
+
+void PowerBudget::setBudget(float amps) {
+    stats.budgetAmps = max(amps, 0.0f);
+}
+
+void PowerBudget::setPriority(PowerPriority newPriority) {
+    priority = newPriority;
+}
+
+void PowerBudget::request(int channel, int pulseUs) {
+    if (channel < 0 || channel >= channelCount) return;
+    channels[channel].requestedUs = pulseUs;
+}
+
+int PowerBudget::granted(int channel) {
+    if (channel < 0 || channel >= channelCount) return 1500;
+    return channels[channel].grantedUs;
+}
+
+int PowerBudget::requested(int channel) {
+    if (channel < 0 || channel >= channelCount) return 1500;
+    return channels[channel].requestedUs;
+}
+
+float PowerBudget::estimateAmps(int channel, int pulseUs) {
+    if (channel < 0 || channel >= channelCount) return 0.0;
+    const Channel& ch = channels[channel];
+    int deflection = min(abs(pulseUs - ch.neutralUs), FULL_DEFLECTION_US);
+    return ch.model.idleAmps + ch.model.fullAmps * deflection / FULL_DEFLECTION_US;
+}
+
+void PowerBudget::resolve() {
+    // Total request, for tuning. Idle draw can't be scaled away, so it
+    // comes off the top and only throttle above neutral is shared out.
+    float requested = 0.0;
+    float idleAmps = 0.0;
+    for (int i = 0; i < channelCount; i++) {
+        requested += estimateAmps(i, channels[i].requestedUs);
+        idleAmps += channels[i].model.idleAmps;
+    }
+    float throttleBudget = max(stats.budgetAmps - idleAmps, 0.0f);
+
+    // High priority group first, low priority group gets the remainder
+    PowerGroup first = (priority == POWER_DRIVE_FIRST) ? POWER_GROUP_DRIVE : POWER_GROUP_WEAPON;
+    PowerGroup second = (priority == POWER_DRIVE_FIRST) ? POWER_GROUP_WEAPON : POWER_GROUP_DRIVE;
+
+    float used = grantGroup(first, throttleBudget);
+    used += grantGroup(second, throttleBudget - used);
+    used += idleAmps;
+
+    // Update statistics
+    stats.requestedAmps = requested;
+    stats.grantedAmps = used;
+    stats.peakRequestedAmps = max(stats.peakRequestedAmps, requested);
+    stats.peakGrantedAmps = max(stats.peakGrantedAmps, used);
+    stats.ticks++;
+    if (requested - used > 0.01) {
+        stats.scaledTicks++;
+    }
+}
+
+float PowerBudget::grantGroup(PowerGroup group, float availableAmps) {
+    float throttleAmps = 0.0;
+    for (int i = 0; i < channelCount; i++) {
+        if (channels[i].group != group) continue;
+        throttleAmps += estimateAmps(i, channels[i].requestedUs) - channels[i].model.idleAmps;
+    }
+
+    float allowed = max(availableAmps, 0.0f);
+    float scale = (throttleAmps > allowed) ? (allowed / throttleAmps) : 1.0;
+
+    // Scale every output in the group by the same amount, toward neutral.
+    // Truncating toward neutral means the grant never rounds over budget.
+    float used = 0.0;
+    for (int i = 0; i < channelCount; i++) {
+        Channel& ch = channels[i];
+        if (ch.group != group) continue;
+        int deflection = constrain(ch.requestedUs - ch.neutralUs,
+                                   -FULL_DEFLECTION_US, FULL_DEFLECTION_US);
+        ch.grantedUs = ch.neutralUs + (int)(deflection * scale);
+        used += estimateAmps(i, ch.grantedUs) - ch.model.idleAmps;
+    }
+
+    return used;
+}
+
+const PowerBudgetStats& PowerBudget::getStats() {
+    return stats;
+}
+
+void PowerBudget::resetStats() {
+    stats.requestedAmps = 0.0;
+    stats.grantedAmps = 0.0;
+    stats.peakRequestedAmps = 0.0;
+    stats.peakGrantedAmps = 0.0;
+    stats.ticks = 0;
+    stats.scaledTicks = 0;
+}
+
+void PowerBudget::printStats() {
+    Serial.printf("[POWER] budget %.1fA | last %.1fA req, %.1fA granted | peak %.1fA req, %.1fA granted | scaled %lu/%lu ticks\n",
+        stats.budgetAmps, stats.requestedAmps, stats.grantedAmps,
+        stats.peakRequestedAmps, stats.peakGrantedAmps,
+        stats.scaledTicks, stats.ticks);
+}
@@ -0,0 +1,107 @@
+// ============================================================================
+// PowerBudget.h - Battery current arbiter for drive and weapon outputs
+//
+// Every ESC output asks the arbiter for its pulse width each tick. The
+// arbiter estimates the current each request would draw and, if the total
+// is over budget, scales the lower-priority outputs back toward neutral.
+//
+// Usage: #include "PowerBudget.h" in your main sketch
+// ============================================================================
+
+#ifndef POWER_BUDGET_H
+#define POWER_BUDGET_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// PRIORITY RULES
+// ============================================================================
+
+enum PowerGroup {
+    POWER_GROUP_DRIVE,
+    POWER_GROUP_WEAPON
+};
+
+enum PowerPriority {
+    POWER_DRIVE_FIRST,    // Drive gets full power, weapon gets what is left
+    POWER_WEAPON_FIRST    // Weapon gets full power, drive gets what is left
+};
+
+// ============================================================================
+// MOTOR MODEL
+// ============================================================================
+// Simple linear current model for one motor + ESC:
+//   amps = idleAmps + fullAmps * (|pulse - neutral| / 500us)
+// Tune fullAmps from your motor's datasheet or a clamp meter reading.
+// ============================================================================
+
+struct MotorModel {
+    float idleAmps;   // Draw at neutral (ESC electronics)
+    float fullAmps;   // Extra draw at full throttle
+};
+
+// ============================================================================
+// BUDGET STATISTICS
+// ============================================================================
+// Numbers from the most recent tick plus running totals, for tuning.
+// ============================================================================
+
+struct PowerBudgetStats {
+    float budgetAmps;          // Configured limit
+    float requestedAmps;       // What the outputs asked for (last tick)
+    float grantedAmps;         // What the outputs got (last tick)
+    float peakRequestedAmps;   // Highest request since last reset
+    float peakGrantedAmps;     // Highest grant since last reset
+    unsigned long ticks;       // Ticks resolved since last reset
+    unsigned long scaledTicks; // Ticks where something was scaled back
+};
+
+// ============================================================================
+// POWER BUDGET CLASS
+// ============================================================================
+
+class PowerBudget {
+public:
+    static const int MAX_CHANNELS = 4;
+
+    // Constructor
+    PowerBudget();
+
+    // Setup - returns channel number, or -1 if all channels are used
+    int addChannel(PowerGroup group, MotorModel model, int neutralUs = 1500);
+
+    // Configuration
+    void setBudget(float amps);
+    void setPriority(PowerPriority priority);
+
+    // Per-tick use: request() each output, resolve() once, then granted()
+    void request(int channel, int pulseUs);
+    void resolve();
+    int granted(int channel);
+    int requested(int channel);
+
+    // Status checking
+    float estimateAmps(int channel, int pulseUs);
+    const PowerBudgetStats& getStats();
+    void resetStats();
+    void printStats();
+
+private:
+    struct Channel {
+        PowerGroup group;
+        MotorModel model;
+        int neutralUs;
+        int requestedUs;
+        int grantedUs;
+    };
+
+    Channel channels[MAX_CHANNELS];
+    int channelCount;
+    PowerPriority priority;
+    PowerBudgetStats stats;
+
+    // Helper methods
+    float grantGroup(PowerGroup group, float availableAmps);
+};
+
+#endif // POWER_BUDGET_H
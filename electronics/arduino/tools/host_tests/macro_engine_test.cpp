@@ -0,0 +1,255 @@
+// ============================================================================
+// macro_engine_test.cpp - Host test for the maneuver macro engine
+//
+// Drives the REAL ManeuverMacro.cpp with hand-picked timestamps and checks
+// step deadlines, timeToNextStep(), combo edge-triggering, abort, and the
+// sketch's input-to-abort decision (macroAbortReason()).
+//
+// See README.md in this folder for build and usage.
+// ============================================================================
+
+#include <cstdio>
+#include <cstring>
+
+#include "ManeuverMacro.h"
+
+// ============================================================================
+// TEST MACROS
+// ============================================================================
+// Same shape as the sketch's CHARGE_MACRO and ESCAPE_MACRO.
+// ============================================================================
+
+const uint16_t COMBO_ESCAPE = 0x0003;   // A + B
+const uint16_t COMBO_CHARGE = 0x000C;   // X + Y
+
+const MacroStep CHARGE_STEPS[] = {
+    { 150000, 0, 512, 100 },
+    { 400000, 512, 0, 100 },
+    { 600000, 0, -512, 100 },
+};
+
+const MacroStep ESCAPE_STEPS[] = {
+    { 150000, 0, 512, MACRO_WEAPON_UNCHANGED },
+    { 400000, 512, 0, MACRO_WEAPON_UNCHANGED },
+};
+
+const MacroBinding BINDINGS[] = {
+    { "Escape", COMBO_ESCAPE, ESCAPE_STEPS, 2 },
+    { "Charge", COMBO_CHARGE, CHARGE_STEPS, 3 },
+};
+
+const unsigned long IDLE = 0xFFFFFFFF;   // timeToNextStep() with nothing running
+
+// ============================================================================
+// TEST HELPERS
+// ============================================================================
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...) do { \
+    checks++; \
+    if (!(cond)) { \
+        failures++; \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+    } \
+} while (0)
+
+static void setupEngine(MacroEngine& engine) {
+    engine.setBindings(BINDINGS, 2);
+    engine.setVerboseDebug(false);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+// Late updates must not push the following steps back
+static void testDeadlineAccumulation() {
+    MacroEngine engine;
+    setupEngine(engine);
+
+    const unsigned long start = 1000;
+    const unsigned long late = 3000;
+    engine.start(&BINDINGS[1], start);
+
+    // Step 1 ends at start + 150ms. Not a microsecond early.
+    CHECK(!engine.update(start + 150000 - 1), "step 1 ended early");
+    CHECK(engine.update(start + 150000 + late), "step 1 didn't end");
+    CHECK(engine.currentStep() == &CHARGE_STEPS[1], "not on step 2");
+
+    // Step 2 still ends 400ms after step 1's deadline, not after the late update
+    unsigned long now = start + 150000 + late;
+    CHECK(engine.timeToNextStep(now) == 400000 - late,
+          "step 2 deadline moved: %lu us left", engine.timeToNextStep(now));
+    CHECK(!engine.update(start + 550000 - 1), "step 2 ended early");
+    CHECK(engine.update(start + 550000), "step 2 didn't end on its deadline");
+
+    // A loop that misses a whole step catches up one step per update,
+    // and the deadlines still come from the table
+    now = start + 550000 + 600000 + 5000;
+    CHECK(engine.update(now), "step 3 didn't end");
+    CHECK(!engine.isRunning(), "macro still running after the last step");
+    CHECK(engine.getMaxLatenessUs() == 5000,
+          "max lateness %lu, expected 5000", engine.getMaxLatenessUs());
+
+    // Two steps overdue at once: one per update, no drift
+    MacroEngine behind;
+    setupEngine(behind);
+    behind.start(&BINDINGS[1], start);
+    now = start + 150000 + 400000 + 10;
+    CHECK(behind.update(now), "overdue step 1 didn't end");
+    CHECK(behind.timeToNextStep(now) == 0, "step 2 should already be due");
+    CHECK(behind.update(now), "overdue step 2 didn't end");
+    CHECK(behind.currentStep() == &CHARGE_STEPS[2], "not on step 3");
+    CHECK(behind.timeToNextStep(now) == 600000 - 10,
+          "step 3 deadline moved: %lu us left", behind.timeToNextStep(now));
+}
+
+static void testTimeToNextStep() {
+    MacroEngine engine;
+    setupEngine(engine);
+
+    CHECK(engine.timeToNextStep(0) == IDLE, "idle engine should report no step");
+
+    const unsigned long start = 50000;
+    engine.start(&BINDINGS[0], start);
+    CHECK(engine.timeToNextStep(start) == 150000,
+          "full step left: %lu", engine.timeToNextStep(start));
+    CHECK(engine.timeToNextStep(start + 100000) == 50000,
+          "part step left: %lu", engine.timeToNextStep(start + 100000));
+    CHECK(engine.timeToNextStep(start + 150000) == 0, "due step should be 0");
+    CHECK(engine.timeToNextStep(start + 200000) == 0, "overdue step should be 0");
+
+    // Asking doesn't advance anything
+    CHECK(engine.currentStep() == &ESCAPE_STEPS[0], "timeToNextStep() changed the step");
+
+    engine.update(start + 150000);
+    engine.update(start + 550000);
+    CHECK(!engine.isRunning(), "macro should be finished");
+    CHECK(engine.timeToNextStep(start + 550000) == IDLE, "finished engine should report no step");
+}
+
+static void testComboEdgeTrigger() {
+    MacroEngine engine;
+    setupEngine(engine);
+    unsigned long now = 0;
+
+    // Half a combo does nothing
+    CHECK(!engine.checkBindings(0x0001, now), "A alone started a macro");
+
+    // The press starts it, with any extra buttons held too
+    CHECK(engine.checkBindings(0x0013, now), "A + B (+ another button) didn't start");
+    CHECK(engine.currentStep() == &ESCAPE_STEPS[0], "wrong macro started");
+
+    // Holding the combo doesn't restart it, while running or after it ends
+    now += 10000;
+    CHECK(!engine.checkBindings(0x0003, now), "held combo restarted a running macro");
+    engine.update(150000);
+    engine.update(550000);
+    now = 600000;
+    CHECK(!engine.isRunning(), "macro should be finished");
+    CHECK(!engine.checkBindings(0x0003, now), "held combo restarted a finished macro");
+
+    // Release and press again starts it again
+    CHECK(!engine.checkBindings(0x0000, now), "release started a macro");
+    CHECK(engine.checkBindings(0x0003, now), "second press didn't start");
+    engine.abort("test");
+
+    // Buttons are tracked while a macro runs: X + Y pressed during Escape
+    // and still held afterwards must not start Charge
+    MacroEngine tracking;
+    setupEngine(tracking);
+    CHECK(tracking.checkBindings(0x0003, 0), "A + B didn't start");
+    CHECK(!tracking.checkBindings(0x000F, 1000), "combo started over a running macro");
+    tracking.abort("test");
+    CHECK(!tracking.checkBindings(0x000C, 2000), "held X + Y started after the abort");
+    CHECK(!tracking.checkBindings(0x0000, 3000), "release started a macro");
+    CHECK(tracking.checkBindings(0x000C, 4000), "X + Y press didn't start");
+    CHECK(tracking.currentStep() == &CHARGE_STEPS[0], "wrong macro started");
+}
+
+// Driver input aborts in the same loop pass - nothing of the macro survives
+static void testAbortSameTick() {
+    MacroEngine engine;
+    setupEngine(engine);
+
+    const unsigned long start = 2000;
+    engine.checkBindings(COMBO_CHARGE, start);
+    unsigned long now = start + 200000;
+    CHECK(engine.update(now), "step 1 didn't end");
+
+    engine.abort("driver input");
+    CHECK(!engine.isRunning(), "still running after abort");
+    CHECK(engine.currentStep() == nullptr, "step setpoints still there after abort");
+    CHECK(!engine.update(now), "update() after abort changed setpoints");
+    CHECK(engine.timeToNextStep(now) == IDLE, "abort left a step deadline");
+
+    // Combo still held in the same report doesn't start it again
+    CHECK(!engine.checkBindings(COMBO_CHARGE, now), "held combo restarted after abort");
+
+    // Later deadlines of the aborted macro never fire
+    CHECK(!engine.update(start + 1150000), "aborted macro's deadline fired");
+
+    // Aborting with nothing running is harmless
+    engine.abort("again");
+    CHECK(!engine.isRunning(), "abort started something");
+}
+
+// The sketch's input-to-abort decision, for the weapon setups it supports
+static void testAbortDecision() {
+    const uint8_t SPINNER_STICK = MACRO_INPUT_RIGHT_STICK_Y;                  // Spinner mode 2
+    const uint8_t SPINNER_R2 = MACRO_INPUT_BRAKE;                             // Spinner/flipper on R2
+    const uint8_t LIFTER_TRIGGERS = MACRO_INPUT_BRAKE | MACRO_INPUT_THROTTLE; // Lifter on both triggers
+    const uint8_t weaponSetups[] = { 0, SPINNER_STICK, SPINNER_R2, MACRO_INPUT_R1, LIFTER_TRIGGERS };
+
+    // Nothing held, or only the weapon's own control - keep going
+    CHECK(macroAbortReason(0, 0) == nullptr, "no input aborted");
+    CHECK(macroAbortReason(SPINNER_STICK, SPINNER_STICK) == nullptr, "spinner stick aborted");
+    CHECK(macroAbortReason(SPINNER_R2, SPINNER_R2) == nullptr, "spinner R2 aborted");
+    CHECK(macroAbortReason(MACRO_INPUT_THROTTLE, LIFTER_TRIGGERS) == nullptr, "lifter trigger aborted");
+
+    // Drive input aborts, with the weapon held or not
+    CHECK(macroAbortReason(MACRO_INPUT_LEFT_STICK, SPINNER_STICK) != nullptr, "left stick didn't abort");
+    CHECK(macroAbortReason(MACRO_INPUT_LEFT_STICK | SPINNER_STICK, SPINNER_STICK) != nullptr,
+          "left stick with the spinner held didn't abort");
+    CHECK(macroAbortReason(MACRO_INPUT_RIGHT_STICK_Y, SPINNER_R2) != nullptr,
+          "right stick didn't abort when the weapon is on R2");
+
+    // The e-stop aborts with every weapon setup - including one that reads
+    // both triggers, where the weapon filter alone would let it through
+    for (uint8_t weaponMask : weaponSetups) {
+        const char* reason = macroAbortReason(MACRO_INPUT_ESTOP, weaponMask);
+        CHECK(reason != nullptr && strcmp(reason, "emergency stop") == 0,
+              "e-stop didn't abort with weapon inputs 0x%02x", weaponMask);
+        reason = macroAbortReason(MACRO_INPUT_ESTOP | MACRO_INPUT_LEFT_STICK, weaponMask);
+        CHECK(reason != nullptr && strcmp(reason, "emergency stop") == 0,
+              "e-stop with steering wasn't reported as an e-stop (weapon inputs 0x%02x)", weaponMask);
+    }
+
+    // End to end: the e-stop report ends the macro in the same pass
+    MacroEngine engine;
+    setupEngine(engine);
+    engine.checkBindings(COMBO_CHARGE, 0);
+    const char* reason = macroAbortReason(MACRO_INPUT_ESTOP, LIFTER_TRIGGERS);
+    if (engine.isRunning() && reason) engine.abort(reason);
+    CHECK(!engine.isRunning() && engine.currentStep() == nullptr,
+          "e-stop report left the macro running");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main() {
+    testDeadlineAccumulation();
+    testTimeToNextStep();
+    testComboEdgeTrigger();
+    testAbortSameTick();
+    testAbortDecision();
+
+    printf("%d checks, %d failures\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+// ============================================================================
+// power_budget_test.cpp - Host test for the power budget arbiter
+//
+// Replays drive and spinner pulse traces through the REAL PowerBudget.cpp
+// on the sketch's loop schedule, and checks that the current granted - and
+// the current of the pulses actually written to the outputs - never goes
+// over the budget, on every loop pass, with either priority rule.
+//
+// See README.md in this folder for build and usage.
+// ============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "PowerBudget.h"
+
+// ============================================================================
+// SKETCH SETTINGS
+// ============================================================================
+// Keep these in step with CombatRobot.ino.
+// ============================================================================
+
+const float POWER_BUDGET_AMPS = 20.0;
+const MotorModel DRIVE_MOTOR_MODEL = { 0.1, 4.0 };
+const MotorModel WEAPON_MOTOR_MODEL = { 0.2, 15.0 };
+
+// Loop pass length. The sketch loops about once per tick (vTaskDelay(1)),
+// and traces are logged every UPDATE_INTERVAL, so requests change between
+// many passes.
+const unsigned long LOOP_PASS_MS = 1;
+
+// Budgets to check: the sketch's own, and tighter ones that force scaling
+const float TEST_BUDGETS[] = { POWER_BUDGET_AMPS, 10.0, 5.0, 1.0 };
+
+// Float rounding allowance when comparing amps
+const float AMPS_TOLERANCE = 0.001;
+
+// ============================================================================
+// TEST HELPERS
+// ============================================================================
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...) do { \
+    checks++; \
+    if (!(cond)) { \
+        failures++; \
+        if (failures <= 20) { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } \
+} while (0)
+
+struct TraceTick {
+    unsigned long ms;
+    int left;
+    int right;
+    int weapon;
+};
+
+// Reads "ms,left,right,weapon" lines. Lines starting with '#' are skipped,
+// and a "[TRACE] " prefix is allowed so serial logs can be used as they are.
+static bool loadTrace(const char* path, std::vector<TraceTick>& trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("Can't open trace %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        const char* text = line;
+        if (strncmp(text, "[TRACE] ", 8) == 0) text += 8;
+        if (text[0] == '#' || text[0] == '\n' || text[0] == '\r') continue;
+
+        TraceTick tick;
+        if (sscanf(text, "%lu,%d,%d,%d", &tick.ms, &tick.left, &tick.right, &tick.weapon) == 4) {
+            trace.push_back(tick);
+        }
+    }
+    fclose(file);
+    return !trace.empty();
+}
+
+// Random trace covering every pulse combination the arbiter can see,
+// including pulses outside 1000-2000us
+static std::vector<TraceTick> randomTrace(uint64_t seed, int count) {
+    std::vector<TraceTick> trace;
+    uint64_t state = seed;
+    for (int i = 0; i < count; i++) {
+        int pulse[3];
+        for (int p = 0; p < 3; p++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            pulse[p] = 900 + (int)((state >> 33) % 1201);   // 900-2100us
+        }
+        trace.push_back({ (unsigned long)i * 10, pulse[0], pulse[1], pulse[2] });
+    }
+    return trace;
+}
+
+// ============================================================================
+// SKETCH OUTPUTS
+// ============================================================================
+// Mirrors updatePowerBudget() in CombatRobot.ino: request, resolve, then
+// write the drive and weapon grants in the same pass. written[] holds the
+// pulse each output is putting out after the pass.
+// ============================================================================
+
+struct SketchOutputs {
+    int channels[3];
+    int written[3];
+};
+
+static void updatePowerBudget(PowerBudget& budget, SketchOutputs& outputs,
+                              const TraceTick& tick) {
+    budget.request(outputs.channels[0], tick.left);
+    budget.request(outputs.channels[1], tick.right);
+    budget.request(outputs.channels[2], tick.weapon);
+    budget.resolve();
+
+    // updateMotors(), then weapon.applyPowerGrant()
+    for (int i = 0; i < 3; i++) {
+        outputs.written[i] = budget.granted(outputs.channels[i]);
+    }
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+static void replay(const char* name, const std::vector<TraceTick>& trace,
+                   PowerPriority priority, float budgetAmps) {
+    PowerBudget budget;
+    int left = budget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL);
+    int right = budget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL);
+    int weapon = budget.addChannel(POWER_GROUP_WEAPON, WEAPON_MOTOR_MODEL);
+    budget.setBudget(budgetAmps);
+    budget.setPriority(priority);
+
+    const char* priorityName = (priority == POWER_DRIVE_FIRST) ? "DRIVE_FIRST" : "WEAPON_FIRST";
+    float idleAmps = 2 * DRIVE_MOTOR_MODEL.idleAmps + WEAPON_MOTOR_MODEL.idleAmps;
+    int failuresBefore = failures;
+
+    // Idle draw can't be scaled away, so the real limit is never below it
+    float limit = max(budgetAmps, idleAmps) + AMPS_TOLERANCE;
+
+    SketchOutputs outputs = { { left, right, weapon }, { 1500, 1500, 1500 } };
+    float peakWrittenAmps = 0;
+    size_t next = 0;
+
+    // One loop pass at a time. Each trace line holds until the next one.
+    for (unsigned long now = trace.front().ms; next < trace.size(); now += LOOP_PASS_MS) {
+        while (next + 1 < trace.size() && trace[next + 1].ms <= now) next++;
+        if (next + 1 == trace.size() && now > trace[next].ms) break;
+        const TraceTick& tick = trace[next];
+
+        updatePowerBudget(budget, outputs, tick);
+
+        const PowerBudgetStats& stats = budget.getStats();
+
+        CHECK(stats.grantedAmps <= limit,
+              "%s %s %.1fA t=%lums: granted %.3fA over budget",
+              name, priorityName, budgetAmps, now, stats.grantedAmps);
+
+        // What the ESCs are actually putting out after this pass
+        float writtenAmps = budget.estimateAmps(left, outputs.written[0])
+                          + budget.estimateAmps(right, outputs.written[1])
+                          + budget.estimateAmps(weapon, outputs.written[2]);
+        peakWrittenAmps = max(peakWrittenAmps, writtenAmps);
+        CHECK(writtenAmps <= limit,
+              "%s %s %.1fA t=%lums: outputs written %d/%d/%dus draw %.3fA, over budget",
+              name, priorityName, budgetAmps, now,
+              outputs.written[0], outputs.written[1], outputs.written[2], writtenAmps);
+
+        // Re-add the grants ourselves so a wrong total in stats can't hide one
+        float sum = budget.estimateAmps(left, budget.granted(left))
+                  + budget.estimateAmps(right, budget.granted(right))
+                  + budget.estimateAmps(weapon, budget.granted(weapon));
+        CHECK(fabs(sum - stats.grantedAmps) <= AMPS_TOLERANCE,
+              "%s %s %.1fA t=%lums: stats %.3fA but grants add up to %.3fA",
+              name, priorityName, budgetAmps, now, stats.grantedAmps, sum);
+
+        // Nothing is ever pushed further from neutral than it asked for
+        int channelsToCheck[] = { left, right, weapon };
+        for (int ch : channelsToCheck) {
+            int asked = abs(budget.requested(ch) - 1500);
+            int got = abs(budget.granted(ch) - 1500);
+            CHECK(got <= asked,
+                  "%s %s %.1fA t=%lums: channel %d granted %dus for %dus",
+                  name, priorityName, budgetAmps, now, ch,
+                  budget.granted(ch), budget.requested(ch));
+        }
+
+        // Under budget, everything passes through untouched. A request right
+        // on the limit may lose 1us to float rounding, which is the safe way.
+        if (stats.requestedAmps <= budgetAmps - AMPS_TOLERANCE) {
+            CHECK(budget.granted(left) == constrain(tick.left, 1000, 2000)
+                  && budget.granted(right) == constrain(tick.right, 1000, 2000)
+                  && budget.granted(weapon) == constrain(tick.weapon, 1000, 2000),
+                  "%s %s %.1fA t=%lums: scaled while under budget",
+                  name, priorityName, budgetAmps, now);
+        }
+    }
+
+    const PowerBudgetStats& stats = budget.getStats();
+    printf("%-12s %-12s %5.1fA  peak %5.2fA req, %5.2fA granted, %5.2fA written  scaled %6lu/%lu  %s\n",
+           name, priorityName, budgetAmps,
+           stats.peakRequestedAmps, stats.peakGrantedAmps, peakWrittenAmps,
+           stats.scaledTicks, stats.ticks,
+           failures == failuresBefore ? "ok" : "FAILED");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char** argv) {
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) paths.push_back(argv[i]);
+    if (paths.empty()) {
+        paths.push_back("traces/match_01.csv");
+        paths.push_back("traces/match_02.csv");
+    }
+
+    std::vector<std::pair<std::string, std::vector<TraceTick>>> traces;
+    for (const std::string& path : paths) {
+        std::vector<TraceTick> trace;
+        if (!loadTrace(path.c_str(), trace)) return 1;
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        traces.push_back({ name, trace });
+    }
+    traces.push_back({ "random", randomTrace(1, 20000) });
+
+    PowerPriority priorities[] = { POWER_DRIVE_FIRST, POWER_WEAPON_FIRST };
+    for (auto& trace : traces) {
+        for (PowerPriority priority : priorities) {
+            for (float budgetAmps : TEST_BUDGETS) {
+                replay(trace.first.c_str(), trace.second, priority, budgetAmps);
+            }
+        }
+    }
+
+    printf("\n%d checks, %d failures\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
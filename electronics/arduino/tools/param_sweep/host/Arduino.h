@@ -0,0 +1,60 @@
+// ============================================================================
+// Arduino.h - Host stand-in for the Arduino core (param_sweep tool only)
+//
+// Just enough of the Arduino API to compile the robot libraries on a PC.
+// Time is simulated and per-thread, so every worker thread runs its own
+// independent robot.
+// ============================================================================
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// Simulated clock
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned long us);
+
+// Simulated pins - read back by the plant models
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+
+// Host tool hooks
+namespace host {
+    const int MAX_PINS = 64;
+
+    void resetClock();
+    void advanceMicros(unsigned long us);
+    int pinValue(int pin);
+    void setPinValue(int pin, int value);
+}
+
+// Serial output is discarded - the tool prints its own results
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    template <typename T> void print(T) {}
+    template <typename T> void println(T) {}
+    void println() {}
+    int printf(const char*, ...) { return 0; }
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
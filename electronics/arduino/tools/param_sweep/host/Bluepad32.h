@@ -0,0 +1,57 @@
+// ============================================================================
+// Bluepad32.h - Host stand-in for Bluepad32 (param_sweep tool only)
+//
+// A scriptable gamepad: the tool sets the fields, the weapons read them.
+// ============================================================================
+
+#ifndef HOST_BLUEPAD32_H
+#define HOST_BLUEPAD32_H
+
+#include <cstdint>
+
+#define BUTTON_A          0x0001
+#define BUTTON_B          0x0002
+#define BUTTON_X          0x0004
+#define BUTTON_Y          0x0008
+#define BUTTON_SHOULDER_L 0x0010
+#define BUTTON_SHOULDER_R 0x0020
+#define BUTTON_TRIGGER_L  0x0040
+#define BUTTON_TRIGGER_R  0x0080
+
+class Controller {
+public:
+    Controller() { release(); }
+
+    // Scripted inputs
+    int lx, ly, rx, ry;
+    int leftTrigger, rightTrigger;
+    bool leftBumper, rightBumper;
+    uint16_t buttonMask;
+
+    void release() {
+        lx = ly = rx = ry = 0;
+        leftTrigger = rightTrigger = 0;
+        leftBumper = rightBumper = false;
+        buttonMask = 0;
+    }
+
+    // Bluepad32 API used by the robot code
+    int axisX() { return lx; }
+    int axisY() { return ly; }
+    int axisRX() { return rx; }
+    int axisRY() { return ry; }
+    int throttle() { return leftTrigger; }
+    int brake() { return rightTrigger; }
+    bool l1() { return leftBumper; }
+    bool r1() { return rightBumper; }
+    bool l2() { return leftTrigger > 0; }
+    bool r2() { return rightTrigger > 0; }
+    uint16_t buttons() { return buttonMask; }
+    bool isConnected() { return true; }
+    bool hasData() { return true; }
+    void playDualRumble(int, int, int, int) {}
+};
+
+typedef Controller* ControllerPtr;
+
+#endif // HOST_BLUEPAD32_H
@@ -0,0 +1,25 @@
+// ============================================================================
+// ESP32Servo.h - Host stand-in for ESP32Servo (param_sweep tool only)
+//
+// Writes land on the simulated pin so the plant models can read them.
+// ============================================================================
+
+#ifndef HOST_ESP32_SERVO_H
+#define HOST_ESP32_SERVO_H
+
+#include <Arduino.h>
+
+class Servo {
+public:
+    Servo() : pin(-1) {}
+
+    void attach(int servoPin, int = 544, int = 2400) { pin = servoPin; }
+    void setPeriodHertz(int) {}
+    void writeMicroseconds(int value) { host::setPinValue(pin, value); }
+    void write(int angle) { host::setPinValue(pin, angle); }
+
+private:
+    int pin;
+};
+
+#endif // HOST_ESP32_SERVO_H
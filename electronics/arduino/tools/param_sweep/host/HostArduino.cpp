@@ -0,0 +1,64 @@
+// ============================================================================
+// HostArduino.cpp - Host stand-in for the Arduino core (param_sweep tool only)
+// ============================================================================
+
+#include <Arduino.h>
+
+HostSerial Serial;
+
+// Each worker thread simulates its own robot
+static thread_local unsigned long simMicros = 0;
+static thread_local int pins[host::MAX_PINS];
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+unsigned long millis() {
+    return simMicros / 1000;
+}
+
+unsigned long micros() {
+    return simMicros;
+}
+
+void delay(unsigned long ms) {
+    simMicros += ms * 1000;
+}
+
+void delayMicroseconds(unsigned long us) {
+    simMicros += us;
+}
+
+void pinMode(int, int) {
+}
+
+void digitalWrite(int pin, int value) {
+    host::setPinValue(pin, value);
+}
+
+namespace host {
+
+void resetClock() {
+    // Start past zero - the weapon code treats time 0 as "never"
+    simMicros = 1000;
+    for (int i = 0; i < MAX_PINS; i++) {
+        pins[i] = 0;
+    }
+}
+
+void advanceMicros(unsigned long us) {
+    simMicros += us;
+}
+
+int pinValue(int pin) {
+    if (pin < 0 || pin >= MAX_PINS) return 0;
+    return pins[pin];
+}
+
+void setPinValue(int pin, int value) {
+    if (pin < 0 || pin >= MAX_PINS) return;
+    pins[pin] = value;
+}
+
+}  // namespace host
@@ -0,0 +1,813 @@
+// ============================================================================
+// param_sweep.cpp - Host-side parameter sweep for the CombatRobot sketch
+//
+// Runs the REAL weapon classes (CombatWeapon.cpp), power budget and drive
+// mixing against simple plant models of the motors, spinner blade and
+// battery. Thousands of parameter combinations run in parallel and each
+// one is scored on spin-up time, peak current, heading error, lift time
+// and flipper misses. Prints a ranked table and the Pareto front.
+//
+// See README.md in this folder for build and usage.
+// ============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CombatWeapon.h"
+#include "DriveMix.h"
+#include "PowerBudget.h"
+
+// ============================================================================
+// SWEEP PARAMETERS
+// ============================================================================
+// Each parameter is swept over an evenly spaced grid. Combinations are
+// drawn from the grid with a seeded random number generator.
+// ============================================================================
+
+struct ParamRange {
+    const char* name;
+    int first;
+    int last;
+    int step;
+};
+
+const ParamRange PARAM_RANGES[] = {
+    { "spinUpTime",       250, 4000, 250 },   // SpinnerWeapon::setSpinUpTime (ms)
+    { "deadZone",          20,  200,  10 },   // JOYSTICK_DEAD_ZONE
+    { "turnBurst",        100,  500,  25 },   // TURN_BURST_DURATION (ms)
+    { "lifterSpeed",       30,  360,  30 },   // LifterWeapon::setSpeed (deg/s)
+    { "fireDuration",      50,  400,  25 },   // FlipperWeapon::setFireDuration (ms)
+    { "cooldownTime",     200, 3000, 200 },   // FlipperWeapon::setCooldownTime (ms)
+};
+
+const int PARAM_COUNT = sizeof(PARAM_RANGES) / sizeof(PARAM_RANGES[0]);
+
+struct Params {
+    int value[PARAM_COUNT];
+
+    int spinUpTime() const { return value[0]; }
+    int deadZone() const { return value[1]; }
+    int turnBurst() const { return value[2]; }
+    int lifterSpeed() const { return value[3]; }
+    int fireDuration() const { return value[4]; }
+    int cooldownTime() const { return value[5]; }
+};
+
+// ============================================================================
+// OBJECTIVES - all minimized
+// ============================================================================
+
+const char* const OBJECTIVE_NAMES[] = {
+    "timeToSpeed_ms", "peakAmps", "headingErr_deg", "liftTime_ms", "flipMiss_pct"
+};
+
+const int OBJECTIVE_COUNT = sizeof(OBJECTIVE_NAMES) / sizeof(OBJECTIVE_NAMES[0]);
+
+struct Result {
+    Params params;
+    double objective[OBJECTIVE_COUNT];
+    double score;
+    bool pareto;
+};
+
+// ============================================================================
+// PLANT MODELS
+// ============================================================================
+// Deliberately simple first-order models for a 1lb robot on a 2S pack.
+// Change the numbers to match your own parts.
+// ============================================================================
+
+// Battery
+const double BATTERY_VOLTS = 8.4;          // Fully charged 2S
+const double BATTERY_OHMS = 0.08;          // Internal resistance (sag)
+
+// Spinner - brushless outrunner + blade
+const double SPINNER_KE = 60.0 / (2.0 * M_PI * 1400.0);  // 1400 Kv, V per rad/s
+const double SPINNER_OHMS = 0.12;
+const double SPINNER_INERTIA = 2.5e-5;     // kg*m^2
+const double SPINNER_FRICTION = 2.0e-6;    // N*m per rad/s
+const double SPINNER_TARGET = 0.70;        // "At speed" = 70% of no-load speed
+
+// Drive - gearmotor, numbers referred to the wheel
+const double DRIVE_KE = 0.4;               // V per wheel rad/s
+const double DRIVE_OHMS = 2.0;
+const double DRIVE_INERTIA = 2.0e-3;       // kg*m^2, includes robot mass
+const double DRIVE_MOVING = 0.50;          // Peak current counts from 50% of no-load speed
+const double WHEEL_RADIUS = 0.02;          // m
+const double TRACK_WIDTH = 0.09;           // m, wheel to wheel
+
+// Lifter - hobby servo under load
+const double LIFTER_SLEW = 300.0;          // deg/s, loaded
+const int LIFTER_TARGET = 88;              // "Lifted" = within 2 degrees of 90
+
+// Flipper - solenoid valve and gas supply
+const int FLIPPER_STROKE_MS = 120;         // Valve open time for a full flip
+const int FLIPPER_GAS_MS = 1500;           // Total valve-open time in a tank
+const int FLIPPER_TAPS = 20;
+
+// Robot settings from CombatRobot.ino
+const DriveConfig DRIVE_CONFIG = { 1000, 2000, true, true, true };
+const MotorModel DRIVE_MOTOR_MODEL = { 0.1, 4.0 };
+const MotorModel WEAPON_MOTOR_MODEL = { 0.2, 15.0 };
+const float POWER_BUDGET_AMPS = 20.0;
+
+// Simulation timing
+const unsigned long TICK_US = 1000;        // Plant step and loop() pass
+const unsigned long REPORT_MS = 10;        // Controller report interval
+
+const int SPINNER_PIN = 8;
+const int LIFTER_PIN = 9;
+const int FLIPPER_PIN = 10;
+
+// ============================================================================
+// RANDOM NUMBERS - SplitMix64, identical on every platform
+// ============================================================================
+
+struct Random {
+    uint64_t state;
+
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    int range(int low, int high) {   // inclusive
+        return low + (int)(next() % (uint64_t)(high - low + 1));
+    }
+};
+
+// ============================================================================
+// MOTOR HELPERS
+// ============================================================================
+
+// Signed duty cycle (-1 to 1) an ESC produces for a pulse width
+double pulseToDuty(int pulseUs) {
+    return constrain((pulseUs - 1500) / 500.0, -1.0, 1.0);
+}
+
+// Drive ESC pulse to wheel duty, undoing the wiring inversion
+double driveDuty(int pulseUs, bool inverted) {
+    int corrected = inverted ? invertSpeed(pulseUs, DRIVE_CONFIG) : pulseUs;
+    return pulseToDuty(corrected);
+}
+
+// One DC motor step. Returns battery current (amps).
+// Neutral is treated as drag brake: the ESC shorts the motor.
+double stepMotor(double& omega, double duty, double volts,
+                 double ke, double ohms, double inertia, double friction, double dt) {
+    double amps = (duty * volts - ke * omega) / ohms;
+    if (duty * amps < 0.0) amps = 0.0;   // No regenerative braking while driven
+    omega += (ke * amps - friction * omega) / inertia * dt;
+    return fabs(duty * amps);
+}
+
+// ============================================================================
+// SCENARIO: CHARGE WITH SPINNER - time to speed and peak current
+// ============================================================================
+// Full-throttle drive charge while the spinner ramps from rest, all
+// through the same power budget the robot uses. Peak current is taken
+// once the drive is moving - the stall inrush at the start is the same
+// for every setting and would hide what the spinner ramp adds.
+// ============================================================================
+
+void simulateCharge(const Params& p, double& timeToSpeedMs, double& peakAmps) {
+    host::resetClock();
+
+    Controller pad;
+    PowerBudget budget;
+    budget.setBudget(POWER_BUDGET_AMPS);
+    budget.setPriority(POWER_DRIVE_FIRST);
+    int leftChannel = budget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL, 1500);
+    int rightChannel = budget.addChannel(POWER_GROUP_DRIVE, DRIVE_MOTOR_MODEL, 1500);
+    int weaponChannel = budget.addChannel(POWER_GROUP_WEAPON, WEAPON_MOTOR_MODEL, 1500);
+
+    SpinnerWeapon spinner(WEAPON_VERTICAL_SPINNER);
+    spinner.setVerboseDebug(false);
+    spinner.setRumbleFeedback(false);
+    spinner.setControlMode(1);      // Hold
+    spinner.setEnableButton(1);     // R1
+    spinner.setSpinUpTime(p.spinUpTime());
+    spinner.setSafetyDelay(0);
+    spinner.begin(SPINNER_PIN);
+    spinner.setPowerBudget(&budget, weaponChannel);
+    spinner.setConnectionTime(millis());
+
+    // Driver holds spinner button and full forward
+    pad.rightBumper = true;
+    DriveSpeeds drive = mixDrive(0, -512, DRIVE_CONFIG);
+
+    double spinnerOmega = 0.0;
+    double leftOmega = 0.0;
+    double rightOmega = 0.0;
+    double batteryAmps = 0.0;
+    double targetOmega = SPINNER_TARGET * BATTERY_VOLTS / SPINNER_KE;
+    double movingOmega = DRIVE_MOVING * BATTERY_VOLTS / DRIVE_KE;
+    const double dt = TICK_US / 1e6;
+    const unsigned long runMs = 4000;
+
+    timeToSpeedMs = runMs;
+    peakAmps = 0.0;
+    unsigned long startMs = millis();
+
+    for (unsigned long t = 0; t < runMs; t++) {
+        if (t % REPORT_MS == 0) {
+            spinner.update(&pad);
+        }
+
+        spinner.service();
+        budget.request(leftChannel, drive.left);
+        budget.request(rightChannel, drive.right);
+        budget.resolve();
+        spinner.applyPowerGrant();
+
+        // Battery sags with last tick's total draw
+        double volts = BATTERY_VOLTS - BATTERY_OHMS * batteryAmps;
+
+        batteryAmps = stepMotor(spinnerOmega, max(pulseToDuty(host::pinValue(SPINNER_PIN)), 0.0),
+                                volts, SPINNER_KE, SPINNER_OHMS, SPINNER_INERTIA, SPINNER_FRICTION, dt);
+        batteryAmps += stepMotor(leftOmega, driveDuty(budget.granted(leftChannel), DRIVE_CONFIG.invertLeft),
+                                 volts, DRIVE_KE, DRIVE_OHMS, DRIVE_INERTIA, 0.0, dt);
+        batteryAmps += stepMotor(rightOmega, driveDuty(budget.granted(rightChannel), DRIVE_CONFIG.invertRight),
+                                 volts, DRIVE_KE, DRIVE_OHMS, DRIVE_INERTIA, 0.0, dt);
+
+        if (fabs(leftOmega) >= movingOmega && fabs(rightOmega) >= movingOmega) {
+            peakAmps = max(peakAmps, batteryAmps);
+        }
+        if (spinnerOmega >= targetOmega && timeToSpeedMs >= runMs) {
+            timeToSpeedMs = millis() - startMs;
+        }
+
+        host::advanceMicros(TICK_US);
+    }
+}
+
+// ============================================================================
+// SCENARIO: DRIVING - heading error
+// ============================================================================
+// Part 1: bumper turn burst, aiming for a 90 degree pivot.
+// Part 2: a driving trace through a worn stick (offset + jitter). Small
+// dead zones let drift steer the robot, big ones swallow gentle turns.
+// ============================================================================
+
+struct DriveState {
+    double leftOmega;
+    double rightOmega;
+    double heading;   // radians
+
+    DriveState() : leftOmega(0.0), rightOmega(0.0), heading(0.0) {}
+
+    void step(const DriveSpeeds& speeds, double dt) {
+        stepMotor(leftOmega, driveDuty(speeds.left, DRIVE_CONFIG.invertLeft),
+                  BATTERY_VOLTS, DRIVE_KE, DRIVE_OHMS, DRIVE_INERTIA, 0.0, dt);
+        stepMotor(rightOmega, driveDuty(speeds.right, DRIVE_CONFIG.invertRight),
+                  BATTERY_VOLTS, DRIVE_KE, DRIVE_OHMS, DRIVE_INERTIA, 0.0, dt);
+        heading += WHEEL_RADIUS * (leftOmega - rightOmega) / TRACK_WIDTH * dt;
+    }
+};
+
+// Intended left stick position during the driving trace
+void driverTrace(unsigned long t, int& axisX, int& axisY) {
+    axisX = 0;
+    axisY = 0;
+    if (t < 2400) axisY = -400;                  // Drive forward
+    if (t >= 1000 && t < 1600) axisX = 110;      // Gentle correction
+}
+
+double simulateDriving(const Params& p, Random& rng) {
+    const double dt = TICK_US / 1e6;
+
+    // Part 1 - bumper turn burst (CombatRobot.ino handleBumperControl)
+    DriveState burst;
+    DriveSpeeds pivot;
+    pivot.left = invertSpeed(DRIVE_CONFIG.maxSpeed, DRIVE_CONFIG);
+    pivot.right = invertSpeed(DRIVE_CONFIG.minSpeed, DRIVE_CONFIG);
+    DriveSpeeds stopped = { 1500, 1500 };
+
+    for (int t = 0; t < 800; t++) {
+        burst.step(t < p.turnBurst() ? pivot : stopped, dt);
+    }
+    double burstError = fabs(fabs(burst.heading) * 180.0 / M_PI - 90.0);
+
+    // Part 2 - worn stick through the real dead zone and mixing
+    int offsetX = rng.range(-60, 60);
+    int offsetY = rng.range(-60, 60);
+
+    DriveState ideal;
+    DriveState actual;
+    int stickX = 0;
+    int stickY = 0;
+
+    for (unsigned long t = 0; t < 3000; t++) {
+        int wantX, wantY;
+        driverTrace(t, wantX, wantY);
+
+        if (t % REPORT_MS == 0) {
+            stickX = constrain(wantX + offsetX + rng.range(-25, 25), -512, 512);
+            stickY = constrain(wantY + offsetY + rng.range(-25, 25), -512, 512);
+        }
+
+        ideal.step(mixDrive(wantX, wantY, DRIVE_CONFIG), dt);
+        actual.step(mixDrive(applyDeadZone(stickX, p.deadZone()),
+                             applyDeadZone(stickY, p.deadZone()), DRIVE_CONFIG), dt);
+    }
+    double trackError = fabs(actual.heading - ideal.heading) * 180.0 / M_PI;
+
+    return burstError + trackError;
+}
+
+// ============================================================================
+// SCENARIO: LIFTER - time to full lift
+// ============================================================================
+
+double simulateLifter(const Params& p) {
+    host::resetClock();
+
+    Controller pad;
+    LifterWeapon lifter;
+    lifter.setVerboseDebug(false);
+    lifter.setUpButton(1);
+    lifter.setDownButton(0);
+    lifter.setControlMode(0);
+    lifter.setRange(0, 90);
+    lifter.setSpeed(p.lifterSpeed());
+    lifter.setSafetyDelay(0);
+    lifter.begin(LIFTER_PIN);
+    lifter.setConnectionTime(millis());
+
+    pad.rightBumper = true;   // Hold "up"
+
+    double armAngle = 0.0;
+    const double dt = TICK_US / 1e6;
+    const unsigned long runMs = 3000;
+
+    for (unsigned long t = 0; t < runMs; t++) {
+        if (t % REPORT_MS == 0) {
+            lifter.update(&pad);
+        }
+
+        // Servo chases its commanded angle at a limited rate
+        double commanded = host::pinValue(LIFTER_PIN);
+        double maxMove = LIFTER_SLEW * dt;
+        armAngle += constrain(commanded - armAngle, -maxMove, maxMove);
+
+        if (armAngle >= LIFTER_TARGET) {
+            return t;
+        }
+        host::advanceMicros(TICK_US);
+    }
+    return runMs;
+}
+
+// ============================================================================
+// SCENARIO: FLIPPER - missed flips
+// ============================================================================
+// The driver taps fire at random moments. A tap is a miss if the flipper
+// is cooling down, the valve closes before a full stroke, or the gas runs
+// out.
+// ============================================================================
+
+double simulateFlipper(const Params& p, Random& rng) {
+    host::resetClock();
+
+    Controller pad;
+    FlipperWeapon flipper;
+    flipper.setVerboseDebug(false);
+    flipper.setEnableButton(1);     // R1
+    flipper.setControlMode(0);      // Tap
+    flipper.setFireDuration(p.fireDuration());
+    flipper.setCooldownTime(p.cooldownTime());
+    flipper.setSafetyDelay(0);
+    flipper.begin(FLIPPER_PIN);
+    flipper.setConnectionTime(millis());
+
+    // Tap schedule
+    unsigned long tapTimes[FLIPPER_TAPS];
+    unsigned long nextTap = 100;
+    for (int i = 0; i < FLIPPER_TAPS; i++) {
+        tapTimes[i] = nextTap;
+        nextTap += rng.range(150, 900);
+    }
+    const unsigned long tapHoldMs = 40;
+
+    int flips = 0;
+    int gasUsedMs = 0;
+    int openMs = 0;
+    int tap = 0;
+
+    for (unsigned long t = 0; t < nextTap + 1000; t++) {
+        while (tap < FLIPPER_TAPS && t >= tapTimes[tap] + tapHoldMs) tap++;
+        pad.rightBumper = (tap < FLIPPER_TAPS && t >= tapTimes[tap]);
+
+        if (t % REPORT_MS == 0) {
+            flipper.update(&pad);
+        }
+
+        // Count each valve opening that lasts a full stroke with gas left
+        if (host::pinValue(FLIPPER_PIN) == HIGH) {
+            openMs++;
+            if (gasUsedMs < FLIPPER_GAS_MS) gasUsedMs++;
+            if (openMs == FLIPPER_STROKE_MS && gasUsedMs < FLIPPER_GAS_MS) flips++;
+        } else {
+            openMs = 0;
+        }
+
+        host::advanceMicros(TICK_US);
+    }
+
+    return 100.0 * (FLIPPER_TAPS - flips) / FLIPPER_TAPS;
+}
+
+// ============================================================================
+// ONE COMBINATION
+// ============================================================================
+
+// Same seed + index always gives the same combination and the same noise,
+// whichever thread runs it
+Params paramsForIndex(uint64_t seed, size_t index) {
+    Random rng(seed ^ (0xA5A5A5A5ULL + index * 0x100000001B3ULL));
+    Params p;
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        const ParamRange& r = PARAM_RANGES[i];
+        int steps = (r.last - r.first) / r.step;
+        p.value[i] = r.first + rng.range(0, steps) * r.step;
+    }
+    return p;
+}
+
+void evaluate(uint64_t seed, size_t index, Result& result) {
+    result.params = paramsForIndex(seed, index);
+    Random noise(seed * 31 + index);
+
+    simulateCharge(result.params, result.objective[0], result.objective[1]);
+    result.objective[2] = simulateDriving(result.params, noise);
+    result.objective[3] = simulateLifter(result.params);
+    result.objective[4] = simulateFlipper(result.params, noise);
+}
+
+// ============================================================================
+// WORK-STEALING THREAD POOL
+// ============================================================================
+// Every worker gets its own queue of index ranges. It works from the back
+// of its own queue and, when empty, steals from the front of the others'.
+// ============================================================================
+
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads) : threadCount(max(threads, 1u)), steals(0) {}
+
+    // Runs job(i) for every i in [0, count) and returns when all are done
+    void parallelFor(size_t count, const std::function<void(size_t)>& job) {
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        for (unsigned w = 0; w < threadCount; w++) {
+            queues.emplace_back(new WorkerQueue());
+        }
+
+        // Small chunks so stealing can even out slow and fast combinations
+        size_t chunk = max<size_t>(1, count / (threadCount * 16));
+        size_t chunkCount = (count + chunk - 1) / chunk;
+        for (size_t c = 0; c < chunkCount; c++) {
+            Range r = { c * chunk, min(count, (c + 1) * chunk) };
+            queues[c * threadCount / chunkCount]->ranges.push_back(r);
+        }
+
+        std::vector<std::thread> workers;
+        for (unsigned w = 0; w < threadCount; w++) {
+            workers.emplace_back([&, w]() {
+                Range r;
+                while (popLocal(*queues[w], r) || steal(queues, w, r)) {
+                    for (size_t i = r.begin; i < r.end; i++) {
+                        job(i);
+                    }
+                }
+            });
+        }
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    unsigned getThreadCount() const { return threadCount; }
+    unsigned long getSteals() const { return steals; }
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Range> ranges;
+    };
+
+    unsigned threadCount;
+    std::atomic<unsigned long> steals;
+
+    bool popLocal(WorkerQueue& queue, Range& r) {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.ranges.empty()) return false;
+        r = queue.ranges.back();
+        queue.ranges.pop_back();
+        return true;
+    }
+
+    // No new work is ever added, so one empty pass means we are done
+    bool steal(std::vector<std::unique_ptr<WorkerQueue>>& queues, unsigned thief, Range& r) {
+        for (unsigned offset = 1; offset < threadCount; offset++) {
+            WorkerQueue& victim = *queues[(thief + offset) % threadCount];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.ranges.empty()) {
+                r = victim.ranges.front();
+                victim.ranges.pop_front();
+                steals++;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// ============================================================================
+// RANKING AND PARETO FRONT
+// ============================================================================
+
+// Score = sum of objectives, each scaled 0 (best seen) to 1 (worst seen)
+void scoreResults(std::vector<Result>& results) {
+    double low[OBJECTIVE_COUNT];
+    double high[OBJECTIVE_COUNT];
+    for (int k = 0; k < OBJECTIVE_COUNT; k++) {
+        low[k] = high[k] = results.empty() ? 0.0 : results[0].objective[k];
+    }
+    for (const Result& r : results) {
+        for (int k = 0; k < OBJECTIVE_COUNT; k++) {
+            low[k] = min(low[k], r.objective[k]);
+            high[k] = max(high[k], r.objective[k]);
+        }
+    }
+    for (Result& r : results) {
+        r.score = 0.0;
+        for (int k = 0; k < OBJECTIVE_COUNT; k++) {
+            if (high[k] > low[k]) {
+                r.score += (r.objective[k] - low[k]) / (high[k] - low[k]);
+            }
+        }
+    }
+}
+
+bool dominates(const Result& a, const Result& b) {
+    bool strictlyBetter = false;
+    for (int k = 0; k < OBJECTIVE_COUNT; k++) {
+        if (a.objective[k] > b.objective[k]) return false;
+        if (a.objective[k] < b.objective[k]) strictlyBetter = true;
+    }
+    return strictlyBetter;
+}
+
+void markPareto(std::vector<Result>& results, WorkStealingPool& pool) {
+    pool.parallelFor(results.size(), [&](size_t i) {
+        results[i].pareto = true;
+        for (size_t j = 0; j < results.size(); j++) {
+            if (j != i && dominates(results[j], results[i])) {
+                results[i].pareto = false;
+                break;
+            }
+        }
+    });
+}
+
+// Ranking order - lower score first, index breaks ties so order is stable
+std::vector<size_t> rankResults(const std::vector<Result>& results) {
+    std::vector<size_t> order(results.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (results[a].score != results[b].score) return results[a].score < results[b].score;
+        return a < b;
+    });
+    return order;
+}
+
+// FNV-1a over every result - equal checksums mean identical runs
+uint64_t checksum(const std::vector<Result>& results) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const Result& r : results) {
+        const unsigned char* bytes = (const unsigned char*)r.objective;
+        for (size_t b = 0; b < sizeof(r.objective); b++) {
+            hash = (hash ^ bytes[b]) * 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+// Two settings of a ramp parameter giving exactly the same result means
+// the ramp in CombatWeapon.cpp is stepping coarser than the sweep - the
+// objective then ranks rounding, not tuning. Warn instead of trusting it.
+// Settings above plantLimit are skipped: there the plant, not the ramp,
+// sets the pace (the lifter servo can't slew faster than LIFTER_SLEW).
+void checkRampResolution(const std::vector<Result>& results, int param, int objective,
+                         int plantLimit) {
+    std::map<double, std::vector<int>> settingsByResult;
+    for (const Result& r : results) {
+        int setting = r.params.value[param];
+        if (setting > plantLimit) continue;
+        std::vector<int>& settings = settingsByResult[r.objective[objective]];
+        if (std::find(settings.begin(), settings.end(), setting) == settings.end()) {
+            settings.push_back(setting);
+        }
+    }
+
+    for (const auto& entry : settingsByResult) {
+        if (entry.second.size() > 1) {
+            printf("WARNING: %s %d and %d both give %s %.0f - ramp steps are\n"
+                   "         being rounded; don't rank on %s (see README)\n\n",
+                PARAM_RANGES[param].name, entry.second[0], entry.second[1],
+                OBJECTIVE_NAMES[objective], entry.first, OBJECTIVE_NAMES[objective]);
+            return;
+        }
+    }
+}
+
+void printHeader() {
+    printf("%5s %7s", "rank", "score");
+    for (int i = 0; i < PARAM_COUNT; i++) printf(" %12s", PARAM_RANGES[i].name);
+    for (int k = 0; k < OBJECTIVE_COUNT; k++) printf(" %14s", OBJECTIVE_NAMES[k]);
+    printf("\n");
+}
+
+void printRow(size_t rank, const Result& r) {
+    printf("%5zu %7.3f", rank, r.score);
+    for (int i = 0; i < PARAM_COUNT; i++) printf(" %12d", r.params.value[i]);
+    for (int k = 0; k < OBJECTIVE_COUNT; k++) printf(" %14.1f", r.objective[k]);
+    printf("\n");
+}
+
+bool writeCsv(const char* path, const std::vector<Result>& results, const std::vector<size_t>& order) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "rank,score,pareto");
+    for (int i = 0; i < PARAM_COUNT; i++) fprintf(file, ",%s", PARAM_RANGES[i].name);
+    for (int k = 0; k < OBJECTIVE_COUNT; k++) fprintf(file, ",%s", OBJECTIVE_NAMES[k]);
+    fprintf(file, "\n");
+
+    for (size_t rank = 0; rank < order.size(); rank++) {
+        const Result& r = results[order[rank]];
+        fprintf(file, "%zu,%.4f,%d", rank + 1, r.score, r.pareto ? 1 : 0);
+        for (int i = 0; i < PARAM_COUNT; i++) fprintf(file, ",%d", r.params.value[i]);
+        for (int k = 0; k < OBJECTIVE_COUNT; k++) fprintf(file, ",%.3f", r.objective[k]);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
+
+// ============================================================================
+// SWEEP
+// ============================================================================
+
+struct SweepTiming {
+    double seconds;
+    double perSecond;
+};
+
+SweepTiming runSweep(uint64_t seed, WorkStealingPool& pool, std::vector<Result>& results) {
+    auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(results.size(), [&](size_t i) {
+        evaluate(seed, i, results[i]);
+    });
+    auto stop = std::chrono::steady_clock::now();
+
+    SweepTiming timing;
+    timing.seconds = std::chrono::duration<double>(stop - start).count();
+    timing.perSecond = results.size() / max(timing.seconds, 1e-9);
+    return timing;
+}
+
+// Run the same sweep on 1, 2, 4 ... threads and compare
+void runScaling(uint64_t seed, size_t samples, unsigned maxThreads) {
+    printf("%8s %10s %14s %9s %11s %18s\n",
+        "threads", "seconds", "combos/sec", "speedup", "efficiency", "checksum");
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    double baseline = 0.0;
+    for (unsigned threads : threadCounts) {
+        WorkStealingPool pool(threads);
+        std::vector<Result> results(samples);
+        SweepTiming timing = runSweep(seed, pool, results);
+
+        if (threads == 1) baseline = timing.perSecond;
+        double speedup = timing.perSecond / baseline;
+        printf("%8u %10.2f %14.1f %8.2fx %10.0f%% %18llx\n",
+            threads, timing.seconds, timing.perSecond, speedup,
+            100.0 * speedup / threads, (unsigned long long)checksum(results));
+    }
+}
+
+void printUsage() {
+    printf("Usage: param_sweep [options]\n"
+           "  --samples N    parameter combinations to try (default 4096)\n"
+           "  --seed N       random seed - same seed, same results (default 1)\n"
+           "  --threads N    worker threads (default: all cores)\n"
+           "  --top N        rows in the ranked table (default 20)\n"
+           "  --csv FILE     write every result, ranked, to FILE\n"
+           "  --scaling      time the sweep on 1, 2, 4 ... threads and exit\n");
+}
+
+int main(int argc, char** argv) {
+    size_t samples = 4096;
+    uint64_t seed = 1;
+    unsigned threads = max(std::thread::hardware_concurrency(), 1u);
+    size_t top = 20;
+    const char* csvPath = nullptr;
+    bool scaling = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--samples" && hasValue) samples = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue) seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue) threads = (unsigned)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--top" && hasValue) top = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--csv" && hasValue) csvPath = argv[++i];
+        else if (arg == "--scaling") scaling = true;
+        else {
+            printUsage();
+            return (arg == "--help") ? 0 : 1;
+        }
+    }
+
+    if (scaling) {
+        runScaling(seed, samples, max(threads, 1u));
+        return 0;
+    }
+
+    WorkStealingPool pool(threads);
+    std::vector<Result> results(samples);
+
+    SweepTiming timing = runSweep(seed, pool, results);
+    scoreResults(results);
+    markPareto(results, pool);
+    std::vector<size_t> order = rankResults(results);
+
+    printf("=== CombatRobot parameter sweep ===\n");
+    printf("%zu combinations, seed %llu, %u threads: %.2f s (%.0f combos/sec, %lu steals)\n",
+        samples, (unsigned long long)seed, pool.getThreadCount(),
+        timing.seconds, timing.perSecond, pool.getSteals());
+    printf("Checksum %llx (same seed + samples = same checksum on any thread count)\n\n",
+        (unsigned long long)checksum(results));
+    checkRampResolution(results, 0, 0, INT_MAX);                  // spinUpTime -> timeToSpeed_ms
+    checkRampResolution(results, 3, 3, (int)LIFTER_SLEW);         // lifterSpeed -> liftTime_ms
+
+    printf("--- Top %zu by combined score (lower is better) ---\n", min(top, order.size()));
+    printHeader();
+    for (size_t rank = 0; rank < order.size() && rank < top; rank++) {
+        printRow(rank + 1, results[order[rank]]);
+    }
+
+    size_t paretoCount = 0;
+    for (const Result& r : results) {
+        if (r.pareto) paretoCount++;
+    }
+    printf("\n--- Pareto front (%zu combinations no other beats on every objective) ---\n", paretoCount);
+    printHeader();
+    for (size_t rank = 0; rank < order.size(); rank++) {
+        if (results[order[rank]].pareto) {
+            printRow(rank + 1, results[order[rank]]);
+        }
+    }
+
+    if (csvPath) {
+        if (!writeCsv(csvPath, results, order)) {
+            fprintf(stderr, "Could not write %s\n", csvPath);
+            return 1;
+        }
+        printf("\nWrote %s\n", csvPath);
+    }
+
+    return 0;
+}